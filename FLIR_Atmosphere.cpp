@@ -0,0 +1,141 @@
+/*
+ * Atmospheric attenuation model sampling X-Plane weather at the camera position and precomputing per-range transmission tables
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "XPLMProcessing.h"
+#include "XPLMUtilities.h"
+#include "XPLMWeather.h"
+#include "FLIR_Atmosphere.h"
+#include "FLIR_VisualEffects.h"
+#include "FLIR_SimState.h"
+
+static XPLMFlightLoopID gWeatherLoop = NULL;
+static float gSampleInterval = 5.0f; // Weather changes slowly, never sample per frame
+
+static float gVisibility = 0.0f;
+static float gHumidity = 0.0f;
+static float gRainRate = 0.0f;
+static float gExtinction = 0.0f; // Per meter, 8-12um band
+static unsigned short gTable[FLIR_RANGE_BUCKETS];
+
+// Absolute humidity in g/m^3 from air temperature and dewpoint (Magnus formula)
+static float AbsoluteHumidity(float temperatureC, float dewpointC)
+{
+    float vapourPressure = 6.112f * expf(17.67f * dewpointC / (dewpointC + 243.5f)); // hPa
+    return 216.7f * vapourPressure / (temperatureC + 273.15f);
+}
+
+// Combined LWIR extinction coefficient per meter
+static float ComputeExtinction(float visibility, float humidity, float rainRate)
+{
+    // Koschmieder haze term; long-wave IR sees through aerosols far better than visible light
+    if (visibility < 50.0f) visibility = 50.0f;
+    float haze = 0.4f * 3.912f / visibility;
+
+    // Water vapour continuum absorption, ~0.3/km at 15 g/m^3
+    float vapour = 2.0e-5f * humidity;
+
+    // Rain extinction, empirical 0.365 * R^0.63 per km with R in mm/h
+    float rain = rainRate > 0.0f ? 0.365f * powf(rainRate, 0.63f) / 1000.0f : 0.0f;
+
+    return haze + vapour + rain;
+}
+
+static void RebuildAttenuationTable(float extinction)
+{
+    for (int i = 0; i < FLIR_RANGE_SKY_BUCKET; i++) {
+        gTable[i] = (unsigned short)(expf(-extinction * BucketToRange(i)) * 256.0f);
+    }
+    gTable[FLIR_RANGE_SKY_BUCKET] = 256;
+
+    SetAttenuationTable(gTable);
+}
+
+static float WeatherLoopCallback(float inElapsedSinceLastCall, float inElapsedTimeSinceLastFlightLoop,
+                                 int inCounter, void* inRefcon)
+{
+    const FLIRSimState* state = GetSimState();
+    if (!state->valid) {
+        return 1.0f;
+    }
+
+    XPLMWeatherInfo_t info;
+    memset(&info, 0, sizeof(info));
+    info.structSize = sizeof(info);
+
+    XPLMGetWeatherAtLocation(state->latitude, state->longitude, state->elevation, &info);
+
+    gVisibility = info.visibility;
+    gHumidity = AbsoluteHumidity(info.temperature_alt, info.dewpoint_alt);
+    gRainRate = fmaxf(info.precip_rate_alt, 0.0f) * 25.0f; // Ratio to mm/h, 1.0 = heavy rain
+
+    float extinction = ComputeExtinction(gVisibility, gHumidity, gRainRate);
+
+    // Only push a new table when transmission actually changes noticeably
+    if (fabsf(extinction - gExtinction) > gExtinction * 0.02f + 1.0e-7f) {
+        gExtinction = extinction;
+        RebuildAttenuationTable(extinction);
+    }
+
+    return gSampleInterval;
+}
+
+void InitializeAtmosphere()
+{
+    XPLMCreateFlightLoop_t params;
+    params.structSize = sizeof(params);
+    params.phase = xplm_FlightLoop_Phase_AfterFlightModel;
+    params.callbackFunc = WeatherLoopCallback;
+    params.refcon = NULL;
+
+    gWeatherLoop = XPLMCreateFlightLoop(&params);
+}
+
+void CleanupAtmosphere()
+{
+    if (gWeatherLoop) {
+        XPLMDestroyFlightLoop(gWeatherLoop);
+        gWeatherLoop = NULL;
+    }
+}
+
+void SetAtmosphereActive(int active)
+{
+    if (gWeatherLoop) {
+        XPLMScheduleFlightLoop(gWeatherLoop, active ? -1.0f : 0.0f, 1);
+    }
+}
+
+void GetAtmosphereStatus(char* statusBuffer, int bufferSize)
+{
+    snprintf(statusBuffer, bufferSize, "ATM: VIS %.1fkm RH %.1fg RAIN %.1fmm T1km %.0f%%",
+             gVisibility / 1000.0f, gHumidity, gRainRate, expf(-gExtinction * 1000.0f) * 100.0f);
+    statusBuffer[bufferSize - 1] = '\0';
+}
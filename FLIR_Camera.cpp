@@ -28,6 +28,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <math.h>
 #include <windows.h>
 #include <GL/gl.h>
@@ -43,40 +44,55 @@
 #include "XPLMGraphics.h"
 #include "XPLMProcessing.h"
 #include "XPLMMenus.h"
+#include "FLIR_Camera.h"
 #include "FLIR_SimpleLock.h"
 #include "FLIR_VisualEffects.h"
+#include "FLIR_Atmosphere.h"
+#include "FLIR_ThermalModel.h"
+#include "FLIR_TerrainClassifier.h"
+#include "FLIR_OverlayGL.h"
+#include "FLIR_OverlayContent.h"
+#include "FLIR_SimState.h"
+#include "FLIR_Mount.h"
+#include "FLIR_Gimbal.h"
+#include "FLIR_Optics.h"
+#include "FLIR_Input.h"
+#include "FLIR_RayCast.h"
+#include "FLIR_Rangefinder.h"
+#include "FLIR_ScanPattern.h"
+#include "FLIR_GLStats.h"
 static XPLMHotKeyID gActivateKey = NULL;
 static XPLMHotKeyID gZoomInKey = NULL;
 static XPLMHotKeyID gZoomOutKey = NULL;
+static XPLMHotKeyID gZoomInReleaseKey = NULL;
+static XPLMHotKeyID gZoomOutReleaseKey = NULL;
 static XPLMHotKeyID gThermalToggleKey = NULL;
 static XPLMHotKeyID gFocusLockKey = NULL;
+static XPLMHotKeyID gScanKey = NULL;
 
-static XPLMDataRef gPlaneX = NULL;
-static XPLMDataRef gPlaneY = NULL;
-static XPLMDataRef gPlaneZ = NULL;
-static XPLMDataRef gPlaneHeading = NULL;
-static XPLMDataRef gPlanePitch = NULL;
-static XPLMDataRef gPlaneRoll = NULL;
 static XPLMDataRef gManipulatorDisabled = NULL;
+static XPLMDataRef gPredictionRef = NULL;
 
 static int gCameraActive = 0;
 static int gDrawCallbackRegistered = 0;
-static float gZoomLevel = 1.0f;
+static int gEffectInputsActive = 0;
 static float gCameraPan = 0.0f;
 static float gCameraTilt = -15.0f;
-static float gCameraHeight = -5.0f;
-static float gCameraDistance = 3.0f;
-static int gLastMouseX = 0;
-static int gLastMouseY = 0;
-static float gMouseSensitivity = 0.2f;
+static FLIRCameraView gCameraView;
+static OverlayGeometry gReticle;
 static void ActivateFLIRCallback(void* inRefcon);
 static void ZoomInCallback(void* inRefcon);
 static void ZoomOutCallback(void* inRefcon);
+static void ZoomReleaseCallback(void* inRefcon);
 static void ThermalToggleCallback(void* inRefcon);
 static void FocusLockCallback(void* inRefcon);
+static void ScanCallback(void* inRefcon);
 static int FLIRCameraFunc(XPLMCameraPosition_t* outCameraPosition, int inIsLosingControl, void* inRefcon);
 static int DrawThermalOverlay(XPLMDrawingPhase inPhase, int inIsBefore, void* inRefcon);
 static void DrawRealisticThermalOverlay(void);
+static float GetPredictionFrames(void* inRefcon);
+static void SetPredictionFrames(void* inRefcon, float inValue);
+static void SetEffectInputsActive(int active);
  
 PLUGIN_API int XPluginStart(char* outName, char* outSig, char* outDesc)
 {
@@ -84,21 +100,36 @@ PLUGIN_API int XPluginStart(char* outName, char* outSig, char* outDesc)
     strcpy(outSig, "flir.camera.system");
     strcpy(outDesc, "Realistic FLIR camera with zoom and thermal overlay");
 
-    gPlaneX = XPLMFindDataRef("sim/flightmodel/position/local_x");
-    gPlaneY = XPLMFindDataRef("sim/flightmodel/position/local_y");
-    gPlaneZ = XPLMFindDataRef("sim/flightmodel/position/local_z");
-    gPlaneHeading = XPLMFindDataRef("sim/flightmodel/position/psi");
-    gPlanePitch = XPLMFindDataRef("sim/flightmodel/position/theta");
-    gPlaneRoll = XPLMFindDataRef("sim/flightmodel/position/phi");
     gManipulatorDisabled = XPLMFindDataRef("sim/operation/prefs/misc/manipulator_disabled");
 
+    InitializeSimState();
+    InitializeMount();
+    InitializeOptics();
+    InitializeInput();
+    InitializeGimbal();
+    InitializeRayCast();
     InitializeSimpleLock();
+    InitializeRangefinder();
+    InitializeScanPattern();
     InitializeVisualEffects();
+    InitializeAtmosphere();
+    InitializeThermalModel();
+    InitializeTerrainClassifier();
+    InitializeGLStats();
+    
+    // Frames of display latency the mount extrapolates over, 0 turns prediction off
+    gPredictionRef = XPLMRegisterDataAccessor("flir/camera/prediction_frames", xplmType_Float, 1,
+                                              NULL, NULL, GetPredictionFrames, SetPredictionFrames,
+                                              NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    
     gActivateKey = XPLMRegisterHotKey(XPLM_VK_F9, xplm_DownFlag, "Activate FLIR Camera", ActivateFLIRCallback, NULL);
     gZoomInKey = XPLMRegisterHotKey(XPLM_VK_EQUAL, xplm_DownFlag, "FLIR Zoom In", ZoomInCallback, NULL);
     gZoomOutKey = XPLMRegisterHotKey(XPLM_VK_MINUS, xplm_DownFlag, "FLIR Zoom Out", ZoomOutCallback, NULL);
+    gZoomInReleaseKey = XPLMRegisterHotKey(XPLM_VK_EQUAL, xplm_UpFlag, "FLIR Zoom In Release", ZoomReleaseCallback, (void*)1);
+    gZoomOutReleaseKey = XPLMRegisterHotKey(XPLM_VK_MINUS, xplm_UpFlag, "FLIR Zoom Out Release", ZoomReleaseCallback, (void*)-1);
     gThermalToggleKey = XPLMRegisterHotKey(XPLM_VK_T, xplm_DownFlag, "FLIR Visual Effects Toggle", ThermalToggleCallback, NULL);
     gFocusLockKey = XPLMRegisterHotKey(XPLM_VK_SPACE, xplm_DownFlag, "FLIR Focus/Lock Target", FocusLockCallback, NULL);
+    gScanKey = XPLMRegisterHotKey(XPLM_VK_F10, xplm_DownFlag, "FLIR Cycle Scan Pattern", ScanCallback, NULL);
 
     return 1;
 }
@@ -107,15 +138,31 @@ PLUGIN_API void XPluginStop(void)
     if (gActivateKey) XPLMUnregisterHotKey(gActivateKey);
     if (gZoomInKey) XPLMUnregisterHotKey(gZoomInKey);
     if (gZoomOutKey) XPLMUnregisterHotKey(gZoomOutKey);
+    if (gZoomInReleaseKey) XPLMUnregisterHotKey(gZoomInReleaseKey);
+    if (gZoomOutReleaseKey) XPLMUnregisterHotKey(gZoomOutReleaseKey);
     if (gThermalToggleKey) XPLMUnregisterHotKey(gThermalToggleKey);
     if (gFocusLockKey) XPLMUnregisterHotKey(gFocusLockKey);
+    if (gScanKey) XPLMUnregisterHotKey(gScanKey);
 
     if (gCameraActive) {
         XPLMDontControlCamera();
         gCameraActive = 0;
     }
     
+    if (gPredictionRef) XPLMUnregisterDataAccessor(gPredictionRef);
+    
+    ReleaseOverlayGeometry(&gReticle);
+    CleanupGimbal();
+    CleanupScanPattern();
+    CleanupRangefinder();
+    CleanupRayCast();
+    CleanupTerrainClassifier();
+    CleanupThermalModel();
+    CleanupAtmosphere();
     CleanupVisualEffects();
+    ReleaseOverlayResources();
+    CleanupGLStats();
+    CleanupSimState();
 }
 PLUGIN_API void XPluginDisable(void) { }
 PLUGIN_API int XPluginEnable(void) { return 1; }
@@ -126,6 +173,7 @@ static void ActivateFLIRCallback(void* inRefcon)
     if (!gCameraActive) {
         XPLMControlCamera(xplm_ControlCameraUntilViewChanges, FLIRCameraFunc, NULL);
         gCameraActive = 1;
+        ResetInput();
         
         if (gManipulatorDisabled) {
             XPLMSetDatai(gManipulatorDisabled, 1);
@@ -138,12 +186,16 @@ static void ActivateFLIRCallback(void* inRefcon)
     } else {
         XPLMDontControlCamera();
         gCameraActive = 0;
+        gCameraView.valid = 0;
         
         if (gManipulatorDisabled) {
             XPLMSetDatai(gManipulatorDisabled, 0);
         }
         
         DisableSimpleLock();
+        StopScan();
+        SetInputEnabled(0);
+        SetEffectInputsActive(0);
         
         if (gDrawCallbackRegistered) {
             XPLMUnregisterDrawCallback(DrawThermalOverlay, xplm_Phase_Window, 0, NULL);
@@ -155,72 +207,34 @@ static void ActivateFLIRCallback(void* inRefcon)
 static void ZoomInCallback(void* inRefcon)
 {
     if (gCameraActive) {
-        if (gZoomLevel < 1.5f) gZoomLevel = 1.5f;
-        else if (gZoomLevel < 2.0f) gZoomLevel = 2.0f;
-        else if (gZoomLevel < 3.0f) gZoomLevel = 3.0f;
-        else if (gZoomLevel < 4.0f) gZoomLevel = 4.0f;
-        else if (gZoomLevel < 6.0f) gZoomLevel = 6.0f;
-        else if (gZoomLevel < 8.0f) gZoomLevel = 8.0f;
-        else if (gZoomLevel < 12.0f) gZoomLevel = 12.0f;
-        else if (gZoomLevel < 16.0f) gZoomLevel = 16.0f;
-        else if (gZoomLevel < 24.0f) gZoomLevel = 24.0f;
-        else if (gZoomLevel < 32.0f) gZoomLevel = 32.0f;
-        else if (gZoomLevel < 48.0f) gZoomLevel = 48.0f;
-        else if (gZoomLevel < 64.0f) gZoomLevel = 64.0f;
-        else gZoomLevel = 64.0f;
+        BeginZoom(1);
     }
 }
  
 static void ZoomOutCallback(void* inRefcon)
 {
     if (gCameraActive) {
-        if (gZoomLevel > 48.0f) gZoomLevel = 48.0f;
-        else if (gZoomLevel > 32.0f) gZoomLevel = 32.0f;
-        else if (gZoomLevel > 24.0f) gZoomLevel = 24.0f;
-        else if (gZoomLevel > 16.0f) gZoomLevel = 16.0f;
-        else if (gZoomLevel > 12.0f) gZoomLevel = 12.0f;
-        else if (gZoomLevel > 8.0f) gZoomLevel = 8.0f;
-        else if (gZoomLevel > 6.0f) gZoomLevel = 6.0f;
-        else if (gZoomLevel > 4.0f) gZoomLevel = 4.0f;
-        else if (gZoomLevel > 3.0f) gZoomLevel = 3.0f;
-        else if (gZoomLevel > 2.0f) gZoomLevel = 2.0f;
-        else if (gZoomLevel > 1.5f) gZoomLevel = 1.5f;
-        else gZoomLevel = 1.0f;
+        BeginZoom(-1);
     }
 }
  
-static float GetZoomBasedSensitivity(float baseSpeed)
+static void ZoomReleaseCallback(void* inRefcon)
 {
-    // Enhanced zoom sensitivity algorithm for all zoom levels
-    // Uses logarithmic scaling for more natural feel
-    
-    // Clamp zoom level to reasonable range
-    float clampedZoom = fmaxf(1.0f, fminf(gZoomLevel, 64.0f));
-    
-    // Logarithmic scaling feels more natural for zoom sensitivity
-    // log(1) = 0, log(64) ≈ 4.16
-    float logZoom = logf(clampedZoom);
-    float maxLogZoom = logf(64.0f); // ≈ 4.16
-    
-    // Normalize to 0-1 range
-    float normalizedZoom = logZoom / maxLogZoom;
-    
-    // Apply sensitivity curve - more aggressive at higher zooms
-    // At 1x zoom: 100% sensitivity
-    // At 2x zoom: ~85% sensitivity  
-    // At 8x zoom: ~50% sensitivity
-    // At 32x zoom: ~15% sensitivity
-    // At 64x zoom: ~3% sensitivity
-    float sensitivityMultiplier = 1.0f - (normalizedZoom * normalizedZoom * 0.97f);
-    
-    // Apply minimum threshold for usability
-    float minSensitivity = baseSpeed * 0.03f; // 3% minimum
-    float finalSensitivity = baseSpeed * sensitivityMultiplier;
-    
-    return fmaxf(finalSensitivity, minSensitivity);
+    EndZoom((int)(ptrdiff_t)inRefcon);
 }
+ 
 
  
+static float GetPredictionFrames(void* inRefcon)
+{
+    return GetMountPrediction();
+}
+ 
+static void SetPredictionFrames(void* inRefcon, float inValue)
+{
+    SetMountPrediction(inValue);
+}
+ 
 static void ThermalToggleCallback(void* inRefcon)
 {
     if (gCameraActive) {
@@ -228,17 +242,56 @@ static void ThermalToggleCallback(void* inRefcon)
     }
 }
 
+static void ScanCallback(void* inRefcon)
+{
+    if (gCameraActive) {
+        CycleScanPattern();
+    }
+}
+
 static void FocusLockCallback(void* inRefcon)
 {
     if (gCameraActive) {
         if (!IsSimpleLockActive()) {
-            LockCurrentDirection(gCameraPan, gCameraTilt);
+            // Lock the ground point under the reticle, or the direction when looking at sky
+            if (!LockBoresightPoint()) {
+                LockCurrentDirection(gCameraPan, gCameraTilt);
+            }
         } else {
             DisableSimpleLock();
         }
     }
 }
  
+// Publish the pose and effective field of view for horizon and footprint math
+static void UpdateCameraView(const XPLMCameraPosition_t* position, const FLIRMountPose* pose)
+{
+    const FLIRSimState* state = GetSimState();
+    
+    float halfTan = tanf(state->fieldOfView * 0.5f * M_PI / 180.0f) / position->zoom;
+    float aspect = state->screenWidth > 0 ? (float)state->screenHeight / state->screenWidth : 0.5625f;
+    
+    gCameraView.x = position->x;
+    gCameraView.y = position->y;
+    gCameraView.z = position->z;
+    gCameraView.elevation = (float)state->elevation + (position->y - state->localY);
+    gCameraView.heading = position->heading;
+    gCameraView.pitch = position->pitch;
+    gCameraView.roll = position->roll;
+    gCameraView.zoom = position->zoom;
+    gCameraView.fovHorizontal = 2.0f * atanf(halfTan) * 180.0f / M_PI;
+    gCameraView.fovVertical = 2.0f * atanf(halfTan * aspect) * 180.0f / M_PI;
+    memcpy(gCameraView.forward, pose->forward, sizeof(gCameraView.forward));
+    memcpy(gCameraView.right, pose->right, sizeof(gCameraView.right));
+    memcpy(gCameraView.up, pose->up, sizeof(gCameraView.up));
+    gCameraView.valid = 1;
+}
+
+void GetFLIRCameraView(FLIRCameraView* outView)
+{
+    *outView = gCameraView;
+}
+ 
 static int FLIRCameraFunc(XPLMCameraPosition_t* outCameraPosition, int inIsLosingControl, void* inRefcon)
 {
     if (inIsLosingControl) {
@@ -251,53 +304,49 @@ static int FLIRCameraFunc(XPLMCameraPosition_t* outCameraPosition, int inIsLosin
             XPLMSetDatai(gManipulatorDisabled, 0);
         }
         DisableSimpleLock();
+        StopScan();
+        SetInputEnabled(0);
+        SetEffectInputsActive(0);
+        gCameraView.valid = 0;
         return 0;
     }
     
-    if (!gPlaneX || !gPlaneY || !gPlaneZ || !gPlaneHeading || !gPlanePitch || !gPlaneRoll) {
-        return 1;
+    // Camera control can start before the snapshot loop has run once
+    const FLIRSimState* state = GetSimState();
+    if (!state->valid) {
+        RefreshSimState();
+        if (!state->valid) return 1;
     }
     
-    float planeX = XPLMGetDataf(gPlaneX);
-    float planeY = XPLMGetDataf(gPlaneY);
-    float planeZ = XPLMGetDataf(gPlaneZ);
-    float planeHeading = XPLMGetDataf(gPlaneHeading);
-    
-    float headingRad = planeHeading * M_PI / 180.0f;
-    
-    outCameraPosition->x = planeX + gCameraDistance * sin(headingRad);
-    outCameraPosition->y = planeY + gCameraHeight;
-    outCameraPosition->z = planeZ + gCameraDistance * cos(headingRad);
+    UpdateMount(state);
     
+    // Pointer motion reaches the gimbal through FLIR_Input on the gimbal's own
+    // loop; a running scan drives the gimbal from its own loop instead
     if (!IsSimpleLockActive()) {
-        int mouseX, mouseY;
-        XPLMGetMouseLocation(&mouseX, &mouseY);
-        
-        if (gLastMouseX != 0 || gLastMouseY != 0) {
-            float zoomBasedMouseSensitivity = GetZoomBasedSensitivity(gMouseSensitivity);
-            float deltaX = (mouseX - gLastMouseX) * zoomBasedMouseSensitivity;
-            float deltaY = (mouseY - gLastMouseY) * zoomBasedMouseSensitivity;
-            
-            gCameraPan += deltaX;
-            gCameraTilt -= deltaY;
-            
-            while (gCameraPan > 180.0f) gCameraPan -= 360.0f;
-            while (gCameraPan < -180.0f) gCameraPan += 360.0f;
-            
-            if (gCameraTilt > 45.0f) gCameraTilt = 45.0f;
-            if (gCameraTilt < -90.0f) gCameraTilt = -90.0f;
-        }
-        
-        gLastMouseX = mouseX;
-        gLastMouseY = mouseY;
+        SetInputEnabled(!IsScanActive());
     } else {
-        GetLockedAngles(&gCameraPan, &gCameraTilt);
+        SetInputEnabled(0);
+        float lockedPan = gCameraPan, lockedTilt = gCameraTilt;
+        GetLockedAngles(&lockedPan, &lockedTilt);
+        SetGimbalTarget(lockedPan, lockedTilt);
     }
     
-    outCameraPosition->heading = planeHeading + gCameraPan;
-    outCameraPosition->pitch = gCameraTilt;
-    outCameraPosition->roll = 0.0f;
-    outCameraPosition->zoom = gZoomLevel;
+    GetGimbalAngles(&gCameraPan, &gCameraTilt);
+    
+    // Pan and tilt are gimbal angles in the body frame, so the line of
+    // sight follows the airframe through pitch and bank
+    FLIRMountPose pose;
+    ComputeMountPose(gCameraPan, gCameraTilt, &pose);
+    
+    outCameraPosition->x = pose.x;
+    outCameraPosition->y = pose.y;
+    outCameraPosition->z = pose.z;
+    outCameraPosition->heading = pose.heading;
+    outCameraPosition->pitch = pose.pitch;
+    outCameraPosition->roll = pose.roll;
+    outCameraPosition->zoom = GetOpticsZoom();
+    
+    UpdateCameraView(outCameraPosition, &pose);
     
     return 1;
 }
@@ -307,85 +356,45 @@ static int DrawThermalOverlay(XPLMDrawingPhase inPhase, int inIsBefore, void* in
     if (!gCameraActive) return 1;
     
     DrawRealisticThermalOverlay();
+    EndGLStatsFrame();
     
     return 1;
 }
 
+// Terrain probes, weather and the thermal model only feed the post-processing
+// kernels, so their loops run only while one of those draws the view
+static void SetEffectInputsActive(int active)
+{
+    if (active == gEffectInputsActive) return;
+    gEffectInputsActive = active;
+    SetTerrainClassifierActive(active);
+    SetAtmosphereActive(active);
+    SetThermalModelActive(active);
+}
+
 static void DrawRealisticThermalOverlay(void)
 {
-    int screenWidth, screenHeight;
-    XPLMGetScreenSize(&screenWidth, &screenHeight);
-    
-    RenderVisualEffects(screenWidth, screenHeight);
+    const FLIRSimState* state = GetSimState();
+    int screenWidth = state->screenWidth;
+    int screenHeight = state->screenHeight;
     
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, screenWidth, screenHeight, 0, -1, 1);
+    // Coordinates are only recomputed when the size or UI scale changes
+    const OverlayLayout* layout = UpdateOverlayLayout(screenWidth, screenHeight, state->uiScale);
     
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    // One overlay pass per frame: effects and reticle share a single state setup
+    BeginOverlayPass(layout);
     
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    float centerX = screenWidth / 2.0f;
-    float centerY = screenHeight / 2.0f;
-    
-    if (IsSimpleLockActive()) {
-        glColor4f(1.0f, 0.0f, 0.0f, 0.9f);
-    } else {
-        glColor4f(0.0f, 1.0f, 0.0f, 0.9f);
+    RenderVisualEffects(screenWidth, screenHeight);
+    SetEffectInputsActive(IsPostProcessingActive());
+    
+    // Reticle geometry only changes with the layout or lock state
+    int locked = IsSimpleLockActive();
+    unsigned int reticleKey = (layout->key << 1) ^ (unsigned int)locked;
+    if (!gReticle.built || gReticle.key != reticleKey) {
+        ResetOverlayGeometry(&gReticle, reticleKey);
+        BuildReticleGeometry(&gReticle, layout, locked);
     }
+    SubmitOverlayGeometry(&gReticle, OVERLAY_LAYER_SYMBOLOGY);
     
-    glLineWidth(2.0f);
-    
-    glBegin(GL_LINES);
-    glVertex2f(centerX - 20, centerY);
-    glVertex2f(centerX + 20, centerY);
-    glVertex2f(centerX, centerY - 20);
-    glVertex2f(centerX, centerY + 20);
-    glEnd();
-    
-    float bracketSize = 50.0f;
-    float bracketLength = 20.0f;
-    
-    glBegin(GL_LINES);
-    glVertex2f(centerX - bracketSize, centerY - bracketSize);
-    glVertex2f(centerX - bracketSize + bracketLength, centerY - bracketSize);
-    glVertex2f(centerX - bracketSize, centerY - bracketSize);
-    glVertex2f(centerX - bracketSize, centerY - bracketSize + bracketLength);
-    
-    glVertex2f(centerX + bracketSize, centerY - bracketSize);
-    glVertex2f(centerX + bracketSize - bracketLength, centerY - bracketSize);
-    glVertex2f(centerX + bracketSize, centerY - bracketSize);
-    glVertex2f(centerX + bracketSize, centerY - bracketSize + bracketLength);
-    
-    glVertex2f(centerX - bracketSize, centerY + bracketSize);
-    glVertex2f(centerX - bracketSize + bracketLength, centerY + bracketSize);
-    glVertex2f(centerX - bracketSize, centerY + bracketSize);
-    glVertex2f(centerX - bracketSize, centerY + bracketSize - bracketLength);
-    
-    glVertex2f(centerX + bracketSize, centerY + bracketSize);
-    glVertex2f(centerX + bracketSize - bracketLength, centerY + bracketSize);
-    glVertex2f(centerX + bracketSize, centerY + bracketSize);
-    glVertex2f(centerX + bracketSize, centerY + bracketSize - bracketLength);
-    glEnd();
-    
-    glPointSize(3.0f);
-    glBegin(GL_POINTS);
-    glVertex2f(centerX, centerY);
-    glEnd();
-    
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
-    glLineWidth(1.0f);
-    glPointSize(1.0f);
-    
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
+    EndOverlayPass();
 }
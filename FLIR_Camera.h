@@ -0,0 +1,56 @@
+/*
+ * Header file for the FLIR camera state shared with the effects and targeting modules
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_CAMERA_H
+#define FLIR_CAMERA_H
+
+// Camera pose as last handed to X-Plane, angles in degrees
+typedef struct {
+    int valid;
+    float x, y, z;          // Local OpenGL coordinates
+    float elevation;        // Meters MSL
+    float heading;
+    float pitch;
+    float roll;             // Positive is right side down
+    float zoom;
+    float fovHorizontal;    // Effective field of view after zoom
+    float fovVertical;
+    float forward[3];       // Line-of-sight basis in local coordinates
+    float right[3];
+    float up[3];
+} FLIRCameraView;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void GetFLIRCameraView(FLIRCameraView* outView);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_CAMERA_H
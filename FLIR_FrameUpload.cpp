@@ -0,0 +1,291 @@
+/*
+ * Streams processed frames to a texture through a ring of unpack buffers
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "XPLMGraphics.h"
+#include "XPLMUtilities.h"
+#include "FLIR_GLExt.h"
+#include "FLIR_FrameUpload.h"
+#include "FLIR_GLStats.h"
+
+#define FRAME_UPLOAD_SLOTS 3
+#define FRAME_FENCE_TIMEOUT_NS 2000000ull // Wait at most 2 ms for the GPU to release a slot
+
+static int gUploadMethod = -1;
+static int gMethodLimit = FRAME_UPLOAD_PERSISTENT;
+static GLuint gSlotBuffers[FRAME_UPLOAD_SLOTS];
+static unsigned char* gSlotMemory[FRAME_UPLOAD_SLOTS]; // Persistent mappings
+static FLIRGLsync gSlotFences[FRAME_UPLOAD_SLOTS];
+static int gSlotCount = 0;
+static int gNextSlot = 0;
+static int gOpenSlot = -1;
+static int gRingWidth = 0;
+static int gRingHeight = 0;
+
+static int gFrameTexture = 0;
+static int gTextureWidth = 0;
+static int gTextureHeight = 0;
+static int gFrameReady = 0;
+static int gStalls = 0;
+static int gUploads = 0;
+static int gLastSlot = -1;
+static int gFenceWaits = 0;
+
+static void ReleaseRing()
+{
+    for (int i = 0; i < gSlotCount; i++) {
+        if (gSlotFences[i]) {
+            flirDeleteSync(gSlotFences[i]);
+            gSlotFences[i] = NULL;
+        }
+        if (gSlotMemory[i]) {
+            flirBindBuffer(GL_PIXEL_UNPACK_BUFFER, gSlotBuffers[i]);
+            flirUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            gSlotMemory[i] = NULL;
+        }
+    }
+    if (gSlotCount) {
+        flirBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        flirDeleteBuffers(gSlotCount, gSlotBuffers);
+    }
+    gSlotCount = 0;
+    gNextSlot = 0;
+    gOpenSlot = -1;
+    gRingWidth = gRingHeight = 0;
+}
+
+static int CreateRing(int width, int height)
+{
+    FLIRGLsizeiptr size = (FLIRGLsizeiptr)width * height * 3;
+
+    flirGenBuffers(FRAME_UPLOAD_SLOTS, gSlotBuffers);
+    gSlotCount = FRAME_UPLOAD_SLOTS;
+    for (int i = 0; i < FRAME_UPLOAD_SLOTS; i++) {
+        flirBindBuffer(GL_PIXEL_UNPACK_BUFFER, gSlotBuffers[i]);
+        if (gUploadMethod == FRAME_UPLOAD_PERSISTENT) {
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            flirBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, NULL, flags);
+            gSlotMemory[i] = (unsigned char*)flirMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags);
+            if (!gSlotMemory[i]) break;
+        } else {
+            flirBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        }
+    }
+    flirBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (gUploadMethod == FRAME_UPLOAD_PERSISTENT && !gSlotMemory[FRAME_UPLOAD_SLOTS - 1]) {
+        ReleaseRing();
+        return 0;
+    }
+
+    gRingWidth = width;
+    gRingHeight = height;
+    return 1;
+}
+
+static void SelectUploadMethod()
+{
+    InitializeGLExtensions();
+    if (HasPersistentMapping()) {
+        gUploadMethod = FRAME_UPLOAD_PERSISTENT;
+    } else if (HasBufferObjects()) {
+        gUploadMethod = FRAME_UPLOAD_ORPHAN;
+    } else {
+        gUploadMethod = FRAME_UPLOAD_CLIENT;
+    }
+    if (gUploadMethod > gMethodLimit) gUploadMethod = gMethodLimit;
+
+    static const char* messages[] = {
+        "FLIR: processed frames uploaded from client memory\n",
+        "FLIR: processed frames streamed through orphaned unpack buffers\n",
+        "FLIR: processed frames streamed through persistently mapped unpack buffers\n"
+    };
+    XPLMDebugString(messages[gUploadMethod]);
+}
+
+// Binds the frame texture to unit 0, (re)allocating it for a new size
+static void BindFrameTexture(int width, int height)
+{
+    if (!gFrameTexture) {
+        XPLMGenerateTextureNumbers(&gFrameTexture, 1);
+    }
+    XPLMBindTexture2d(gFrameTexture, 0);
+    if (gTextureWidth != width || gTextureHeight != height) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        gTextureWidth = width;
+        gTextureHeight = height;
+        gFrameReady = 0;
+    }
+}
+
+// Rows are tightly packed RGB, so the default 4-byte alignment only fits some widths
+static void TexSubImageFrame(const void* pixels, int width, int height)
+{
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+    gFrameReady = 1;
+}
+
+unsigned char* BeginFrameUpload(int width, int height)
+{
+    if (gUploadMethod < 0) SelectUploadMethod();
+    if (gUploadMethod == FRAME_UPLOAD_CLIENT) return NULL;
+
+    if (gRingWidth != width || gRingHeight != height) {
+        ReleaseRing();
+        if (!CreateRing(width, height)) {
+            // Persistent mapping refused, the orphaning path needs nothing special
+            XPLMDebugString("FLIR: persistent frame upload unavailable, orphaning buffers instead\n");
+            gUploadMethod = FRAME_UPLOAD_ORPHAN;
+            if (!CreateRing(width, height)) return NULL;
+        }
+    }
+
+    int slot = gNextSlot;
+    unsigned char* memory = NULL;
+
+    if (gUploadMethod == FRAME_UPLOAD_PERSISTENT) {
+        // The GPU may still be sourcing an earlier frame from this slot
+        if (gSlotFences[slot]) {
+            gFenceWaits++;
+            GLenum result = flirClientWaitSync(gSlotFences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, FRAME_FENCE_TIMEOUT_NS);
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+                gStalls++;
+                return NULL;
+            }
+            flirDeleteSync(gSlotFences[slot]);
+            gSlotFences[slot] = NULL;
+        }
+        memory = gSlotMemory[slot];
+    } else {
+        // Re-specifying the store detaches it from any pending transfer
+        FLIRGLsizeiptr size = (FLIRGLsizeiptr)width * height * 3;
+        flirBindBuffer(GL_PIXEL_UNPACK_BUFFER, gSlotBuffers[slot]);
+        flirBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        memory = (unsigned char*)flirMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+        // Never leave an unpack buffer bound, other uploads pass client pointers
+        flirBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!memory) return NULL;
+    }
+
+    gOpenSlot = slot;
+    return memory;
+}
+
+void EndFrameUpload()
+{
+    if (gOpenSlot < 0) return;
+    int slot = gOpenSlot;
+    gOpenSlot = -1;
+    gNextSlot = (slot + 1) % gSlotCount;
+
+    BindFrameTexture(gRingWidth, gRingHeight);
+    flirBindBuffer(GL_PIXEL_UNPACK_BUFFER, gSlotBuffers[slot]);
+    if (gUploadMethod != FRAME_UPLOAD_PERSISTENT && !flirUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+        // Contents were lost (e.g. mode switch), keep the previous frame
+        flirBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return;
+    }
+    TexSubImageFrame((const void*)0, gRingWidth, gRingHeight);
+    flirBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    gUploads++;
+    gLastSlot = slot;
+
+    if (gUploadMethod == FRAME_UPLOAD_PERSISTENT) {
+        gSlotFences[slot] = flirFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+void UploadFrame(const unsigned char* pixels, int width, int height)
+{
+    BindFrameTexture(width, height);
+    TexSubImageFrame(pixels, width, height);
+}
+
+int DrawUploadedFrame(int screenWidth, int screenHeight)
+{
+    if (!gFrameReady || gTextureWidth != screenWidth || gTextureHeight != screenHeight) {
+        return 0;
+    }
+
+    XPLMSetGraphicsState(0, 1, 0, 0, 0, 0, 0);
+    XPLMBindTexture2d(gFrameTexture, 0);
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    DrawScreenQuad(screenWidth, screenHeight);
+
+    XPLMSetGraphicsState(0, 0, 0, 0, 1, 0, 0);
+    return 1;
+}
+
+void ReleaseFrameUpload()
+{
+    if (gSlotCount) ReleaseRing();
+    if (gFrameTexture) {
+        GLuint texture = (GLuint)gFrameTexture;
+        glDeleteTextures(1, &texture);
+        gFrameTexture = 0;
+    }
+    gTextureWidth = gTextureHeight = 0;
+    gFrameReady = 0;
+    gUploadMethod = -1;
+    gStalls = 0;
+    gUploads = 0;
+    gLastSlot = -1;
+    gFenceWaits = 0;
+}
+
+void GetFrameUploadStatus(char* statusBuffer, int bufferSize)
+{
+    static const char* methods[] = { "CLIENT", "ORPHAN", "PERSISTENT" };
+    snprintf(statusBuffer, bufferSize, "UPL: %s STALLS %d",
+             gUploadMethod >= 0 ? methods[gUploadMethod] : "IDLE", gStalls);
+    statusBuffer[bufferSize - 1] = '\0';
+}
+
+void GetFrameUploadStats(FLIRFrameUploadStats* outStats)
+{
+    outStats->method = gUploadMethod;
+    outStats->uploads = gUploads;
+    outStats->slot = gLastSlot;
+    outStats->fenceWaits = gFenceWaits;
+    outStats->stalls = gStalls;
+}
+
+void LimitFrameUploadMethod(int method)
+{
+    ReleaseFrameUpload();
+    gMethodLimit = method;
+}
@@ -0,0 +1,72 @@
+/*
+ * Header file for streaming processed frames to a texture
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_FRAMEUPLOAD_H
+#define FLIR_FRAMEUPLOAD_H
+
+// How frames reach the texture, best first when the driver allows it
+#define FRAME_UPLOAD_CLIENT 0       // glTexSubImage2D straight from client memory
+#define FRAME_UPLOAD_ORPHAN 1       // Re-specified buffer mapped each frame, driver handles reuse
+#define FRAME_UPLOAD_PERSISTENT 2   // Mapped once, reuse tracked with fences
+
+typedef struct {
+    int method;                 // FRAME_UPLOAD_*, -1 before the first frame
+    int uploads;                // Frames that went through a ring slot
+    int slot;                   // Ring slot of the last of those
+    int fenceWaits;             // Slot reuses that had to check a fence first
+    int stalls;                 // ... where the GPU still held the slot and the frame was dropped
+} FLIRFrameUploadStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns upload memory for one width x height RGB frame (bottom row first) that
+// the kernel can write into directly, or NULL when no ring slot is available.
+// Every non-NULL return must be followed by EndFrameUpload before the next call.
+unsigned char* BeginFrameUpload(int width, int height);
+void EndFrameUpload();
+
+// Fallback for frames written to client memory
+void UploadFrame(const unsigned char* pixels, int width, int height);
+
+// Draws the last uploaded frame as a screen quad. Returns 0 when nothing has
+// been uploaded at this size yet.
+int DrawUploadedFrame(int screenWidth, int screenHeight);
+
+void ReleaseFrameUpload();
+void GetFrameUploadStatus(char* statusBuffer, int bufferSize);
+void GetFrameUploadStats(FLIRFrameUploadStats* outStats);
+
+// Caps the method picked on the next frame, so the slower paths can be
+// exercised on drivers that support the fast one. Releases the current ring.
+void LimitFrameUploadMethod(int method);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_FRAMEUPLOAD_H
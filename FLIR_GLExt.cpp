@@ -0,0 +1,221 @@
+/*
+ * Runtime loader for the OpenGL extension entry points used by the FLIR effects
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "XPLMGraphics.h"
+#include "XPLMUtilities.h"
+#include "FLIR_GLExt.h"
+#include "FLIR_GLStats.h"
+
+FLIRGenBuffersProc flirGenBuffers = NULL;
+FLIRDeleteBuffersProc flirDeleteBuffers = NULL;
+FLIRBindBufferProc flirBindBuffer = NULL;
+FLIRBufferDataProc flirBufferData = NULL;
+FLIRMapBufferProc flirMapBuffer = NULL;
+FLIRUnmapBufferProc flirUnmapBuffer = NULL;
+FLIRMapBufferRangeProc flirMapBufferRange = NULL;
+FLIRBufferStorageProc flirBufferStorage = NULL;
+
+FLIRFenceSyncProc flirFenceSync = NULL;
+FLIRClientWaitSyncProc flirClientWaitSync = NULL;
+FLIRDeleteSyncProc flirDeleteSync = NULL;
+
+FLIRCreateShaderProc flirCreateShader = NULL;
+FLIRShaderSourceProc flirShaderSource = NULL;
+FLIRCompileShaderProc flirCompileShader = NULL;
+FLIRGetShaderivProc flirGetShaderiv = NULL;
+FLIRGetShaderInfoLogProc flirGetShaderInfoLog = NULL;
+FLIRDeleteShaderProc flirDeleteShader = NULL;
+FLIRCreateProgramProc flirCreateProgram = NULL;
+FLIRAttachShaderProc flirAttachShader = NULL;
+FLIRLinkProgramProc flirLinkProgram = NULL;
+FLIRGetProgramivProc flirGetProgramiv = NULL;
+FLIRGetProgramInfoLogProc flirGetProgramInfoLog = NULL;
+FLIRDeleteProgramProc flirDeleteProgram = NULL;
+FLIRUseProgramProc flirUseProgram = NULL;
+FLIRGetUniformLocationProc flirGetUniformLocation = NULL;
+FLIRUniform1iProc flirUniform1i = NULL;
+FLIRUniform1fProc flirUniform1f = NULL;
+FLIRUniform1fvProc flirUniform1fv = NULL;
+FLIRUniform2fProc flirUniform2f = NULL;
+FLIRUniform3fProc flirUniform3f = NULL;
+
+static int gExtensionsLoaded = 0;
+static int gHasBufferObjects = 0;
+static int gHasShaders = 0;
+static int gHasFences = 0;
+static int gHasPersistentMapping = 0;
+
+static void* LoadGLProc(const char* name)
+{
+    void* proc = (void*)wglGetProcAddress(name);
+
+    // wglGetProcAddress may hand back small sentinel values instead of NULL
+    if (proc == (void*)1 || proc == (void*)2 || proc == (void*)3 || proc == (void*)-1) {
+        proc = NULL;
+    }
+    return proc;
+}
+
+void InitializeGLExtensions()
+{
+    if (gExtensionsLoaded) return;
+    gExtensionsLoaded = 1;
+
+    flirGenBuffers = (FLIRGenBuffersProc)LoadGLProc("glGenBuffers");
+    flirDeleteBuffers = (FLIRDeleteBuffersProc)LoadGLProc("glDeleteBuffers");
+    flirBindBuffer = (FLIRBindBufferProc)LoadGLProc("glBindBuffer");
+    flirBufferData = (FLIRBufferDataProc)LoadGLProc("glBufferData");
+    flirMapBuffer = (FLIRMapBufferProc)LoadGLProc("glMapBuffer");
+    flirUnmapBuffer = (FLIRUnmapBufferProc)LoadGLProc("glUnmapBuffer");
+
+    gHasBufferObjects = flirGenBuffers && flirDeleteBuffers && flirBindBuffer &&
+                        flirBufferData && flirMapBuffer && flirUnmapBuffer;
+
+    if (!gHasBufferObjects) {
+        XPLMDebugString("FLIR: buffer objects unavailable, async readbacks disabled\n");
+    }
+
+    flirMapBufferRange = (FLIRMapBufferRangeProc)LoadGLProc("glMapBufferRange");
+    flirBufferStorage = (FLIRBufferStorageProc)LoadGLProc("glBufferStorage");
+    flirFenceSync = (FLIRFenceSyncProc)LoadGLProc("glFenceSync");
+    flirClientWaitSync = (FLIRClientWaitSyncProc)LoadGLProc("glClientWaitSync");
+    flirDeleteSync = (FLIRDeleteSyncProc)LoadGLProc("glDeleteSync");
+
+    gHasFences = flirFenceSync && flirClientWaitSync && flirDeleteSync;
+    gHasPersistentMapping = gHasBufferObjects && gHasFences && flirMapBufferRange && flirBufferStorage;
+
+    flirCreateShader = (FLIRCreateShaderProc)LoadGLProc("glCreateShader");
+    flirShaderSource = (FLIRShaderSourceProc)LoadGLProc("glShaderSource");
+    flirCompileShader = (FLIRCompileShaderProc)LoadGLProc("glCompileShader");
+    flirGetShaderiv = (FLIRGetShaderivProc)LoadGLProc("glGetShaderiv");
+    flirGetShaderInfoLog = (FLIRGetShaderInfoLogProc)LoadGLProc("glGetShaderInfoLog");
+    flirDeleteShader = (FLIRDeleteShaderProc)LoadGLProc("glDeleteShader");
+    flirCreateProgram = (FLIRCreateProgramProc)LoadGLProc("glCreateProgram");
+    flirAttachShader = (FLIRAttachShaderProc)LoadGLProc("glAttachShader");
+    flirLinkProgram = (FLIRLinkProgramProc)LoadGLProc("glLinkProgram");
+    flirGetProgramiv = (FLIRGetProgramivProc)LoadGLProc("glGetProgramiv");
+    flirGetProgramInfoLog = (FLIRGetProgramInfoLogProc)LoadGLProc("glGetProgramInfoLog");
+    flirDeleteProgram = (FLIRDeleteProgramProc)LoadGLProc("glDeleteProgram");
+    flirUseProgram = (FLIRUseProgramProc)LoadGLProc("glUseProgram");
+    flirGetUniformLocation = (FLIRGetUniformLocationProc)LoadGLProc("glGetUniformLocation");
+    flirUniform1i = (FLIRUniform1iProc)LoadGLProc("glUniform1i");
+    flirUniform1f = (FLIRUniform1fProc)LoadGLProc("glUniform1f");
+    flirUniform1fv = (FLIRUniform1fvProc)LoadGLProc("glUniform1fv");
+    flirUniform2f = (FLIRUniform2fProc)LoadGLProc("glUniform2f");
+    flirUniform3f = (FLIRUniform3fProc)LoadGLProc("glUniform3f");
+
+    gHasShaders = flirCreateShader && flirShaderSource && flirCompileShader && flirGetShaderiv &&
+                  flirGetShaderInfoLog && flirDeleteShader && flirCreateProgram && flirAttachShader &&
+                  flirLinkProgram && flirGetProgramiv && flirGetProgramInfoLog && flirDeleteProgram &&
+                  flirUseProgram && flirGetUniformLocation && flirUniform1i && flirUniform1f &&
+                  flirUniform1fv && flirUniform2f && flirUniform3f;
+
+    if (!gHasShaders) {
+        XPLMDebugString("FLIR: GLSL unavailable, post-processing stays on the CPU\n");
+    }
+}
+
+int HasBufferObjects()
+{
+    return gHasBufferObjects;
+}
+
+int HasShaders()
+{
+    return gHasShaders;
+}
+
+int HasFences()
+{
+    return gHasFences;
+}
+
+int HasPersistentMapping()
+{
+    return gHasPersistentMapping;
+}
+
+GLuint BuildFragmentProgram(const char* prelude, const char* source, const char* name)
+{
+    const FLIRGLchar* sources[2] = { prelude, source };
+    char message[128];
+    char log[1024];
+    GLint status = 0;
+
+    GLuint shader = flirCreateShader(GL_FRAGMENT_SHADER);
+    flirShaderSource(shader, 2, sources, NULL);
+    flirCompileShader(shader);
+    flirGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (!status) {
+        flirGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        snprintf(message, sizeof(message), "FLIR: %s shader failed to compile:\n", name);
+        XPLMDebugString(message);
+        XPLMDebugString(log);
+        flirDeleteShader(shader);
+        return 0;
+    }
+
+    GLuint program = flirCreateProgram();
+    flirAttachShader(program, shader);
+    flirLinkProgram(program);
+    flirDeleteShader(shader); // Stays alive while attached
+    flirGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) {
+        flirGetProgramInfoLog(program, sizeof(log), NULL, log);
+        snprintf(message, sizeof(message), "FLIR: %s shader failed to link:\n", name);
+        XPLMDebugString(message);
+        XPLMDebugString(log);
+        flirDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// Uploads all go through unit 0 so they never depend on which unit
+// XPLMBindTexture2d leaves active
+void BindLookupTexture(int texture, int allocate)
+{
+    XPLMBindTexture2d(texture, 0);
+    if (allocate) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+}
+
+void DrawScreenQuad(int width, int height)
+{
+    glBegin(GL_QUADS);
+    glTexCoord2f(0, 0); glVertex2f(0, 0);
+    glTexCoord2f(1, 0); glVertex2f(width, 0);
+    glTexCoord2f(1, 1); glVertex2f(width, height);
+    glTexCoord2f(0, 1); glVertex2f(0, height);
+    glEnd();
+}
@@ -0,0 +1,191 @@
+/*
+ * Header file for OpenGL extension entry points used by the FLIR effects
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_GLEXT_H
+#define FLIR_GLEXT_H
+
+#include <stddef.h>
+#include <windows.h>
+#include <GL/gl.h>
+
+// opengl32 only exports GL 1.1, everything newer is fetched at runtime
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_READ_ONLY
+#define GL_READ_ONLY 0x88B8
+#endif
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#ifndef GL_WRITE_ONLY
+#define GL_WRITE_ONLY 0x88B9
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED 0x911C
+#endif
+
+typedef ptrdiff_t FLIRGLsizeiptr;
+typedef ptrdiff_t FLIRGLintptr;
+typedef char FLIRGLchar;
+typedef unsigned long long FLIRGLuint64;
+typedef struct __FLIRGLsync* FLIRGLsync;
+
+typedef void (APIENTRY *FLIRGenBuffersProc)(GLsizei n, GLuint* buffers);
+typedef void (APIENTRY *FLIRDeleteBuffersProc)(GLsizei n, const GLuint* buffers);
+typedef void (APIENTRY *FLIRBindBufferProc)(GLenum target, GLuint buffer);
+typedef void (APIENTRY *FLIRBufferDataProc)(GLenum target, FLIRGLsizeiptr size, const void* data, GLenum usage);
+typedef void* (APIENTRY *FLIRMapBufferProc)(GLenum target, GLenum access);
+typedef GLboolean (APIENTRY *FLIRUnmapBufferProc)(GLenum target);
+typedef void* (APIENTRY *FLIRMapBufferRangeProc)(GLenum target, FLIRGLintptr offset, FLIRGLsizeiptr length, GLbitfield access);
+typedef void (APIENTRY *FLIRBufferStorageProc)(GLenum target, FLIRGLsizeiptr size, const void* data, GLbitfield flags);
+
+typedef FLIRGLsync (APIENTRY *FLIRFenceSyncProc)(GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRY *FLIRClientWaitSyncProc)(FLIRGLsync sync, GLbitfield flags, FLIRGLuint64 timeout);
+typedef void (APIENTRY *FLIRDeleteSyncProc)(FLIRGLsync sync);
+
+typedef GLuint (APIENTRY *FLIRCreateShaderProc)(GLenum type);
+typedef void (APIENTRY *FLIRShaderSourceProc)(GLuint shader, GLsizei count, const FLIRGLchar* const* source, const GLint* length);
+typedef void (APIENTRY *FLIRCompileShaderProc)(GLuint shader);
+typedef void (APIENTRY *FLIRGetShaderivProc)(GLuint shader, GLenum pname, GLint* params);
+typedef void (APIENTRY *FLIRGetShaderInfoLogProc)(GLuint shader, GLsizei bufSize, GLsizei* length, FLIRGLchar* infoLog);
+typedef void (APIENTRY *FLIRDeleteShaderProc)(GLuint shader);
+typedef GLuint (APIENTRY *FLIRCreateProgramProc)(void);
+typedef void (APIENTRY *FLIRAttachShaderProc)(GLuint program, GLuint shader);
+typedef void (APIENTRY *FLIRLinkProgramProc)(GLuint program);
+typedef void (APIENTRY *FLIRGetProgramivProc)(GLuint program, GLenum pname, GLint* params);
+typedef void (APIENTRY *FLIRGetProgramInfoLogProc)(GLuint program, GLsizei bufSize, GLsizei* length, FLIRGLchar* infoLog);
+typedef void (APIENTRY *FLIRDeleteProgramProc)(GLuint program);
+typedef void (APIENTRY *FLIRUseProgramProc)(GLuint program);
+typedef GLint (APIENTRY *FLIRGetUniformLocationProc)(GLuint program, const FLIRGLchar* name);
+typedef void (APIENTRY *FLIRUniform1iProc)(GLint location, GLint v0);
+typedef void (APIENTRY *FLIRUniform1fProc)(GLint location, GLfloat v0);
+typedef void (APIENTRY *FLIRUniform1fvProc)(GLint location, GLsizei count, const GLfloat* value);
+typedef void (APIENTRY *FLIRUniform2fProc)(GLint location, GLfloat v0, GLfloat v1);
+typedef void (APIENTRY *FLIRUniform3fProc)(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern FLIRGenBuffersProc flirGenBuffers;
+extern FLIRDeleteBuffersProc flirDeleteBuffers;
+extern FLIRBindBufferProc flirBindBuffer;
+extern FLIRBufferDataProc flirBufferData;
+extern FLIRMapBufferProc flirMapBuffer;
+extern FLIRUnmapBufferProc flirUnmapBuffer;
+extern FLIRMapBufferRangeProc flirMapBufferRange;
+extern FLIRBufferStorageProc flirBufferStorage;
+
+extern FLIRFenceSyncProc flirFenceSync;
+extern FLIRClientWaitSyncProc flirClientWaitSync;
+extern FLIRDeleteSyncProc flirDeleteSync;
+
+extern FLIRCreateShaderProc flirCreateShader;
+extern FLIRShaderSourceProc flirShaderSource;
+extern FLIRCompileShaderProc flirCompileShader;
+extern FLIRGetShaderivProc flirGetShaderiv;
+extern FLIRGetShaderInfoLogProc flirGetShaderInfoLog;
+extern FLIRDeleteShaderProc flirDeleteShader;
+extern FLIRCreateProgramProc flirCreateProgram;
+extern FLIRAttachShaderProc flirAttachShader;
+extern FLIRLinkProgramProc flirLinkProgram;
+extern FLIRGetProgramivProc flirGetProgramiv;
+extern FLIRGetProgramInfoLogProc flirGetProgramInfoLog;
+extern FLIRDeleteProgramProc flirDeleteProgram;
+extern FLIRUseProgramProc flirUseProgram;
+extern FLIRGetUniformLocationProc flirGetUniformLocation;
+extern FLIRUniform1iProc flirUniform1i;
+extern FLIRUniform1fProc flirUniform1f;
+extern FLIRUniform1fvProc flirUniform1fv;
+extern FLIRUniform2fProc flirUniform2f;
+extern FLIRUniform3fProc flirUniform3f;
+
+// Must be called with the sim's GL context current (i.e. from a draw callback)
+void InitializeGLExtensions();
+int HasBufferObjects();
+int HasShaders();
+int HasFences();
+// Immutable storage that stays mapped while the GPU reads it (GL 4.4 / ARB_buffer_storage)
+int HasPersistentMapping();
+
+// Compiles and links a GLSL 1.20 fragment-only program. The prelude carries the
+// #defines shared with the C side and goes ahead of the body; failures are
+// logged under the given name and return 0.
+GLuint BuildFragmentProgram(const char* prelude, const char* source, const char* name);
+// Binds on unit 0 for uploads; on first use the texture is set nearest and clamped
+void BindLookupTexture(int texture, int allocate);
+// One quad over the whole screen in the sim's 2D projection, origin bottom left,
+// texture coordinates spanning 0..1
+void DrawScreenQuad(int width, int height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_GLEXT_H
@@ -0,0 +1,231 @@
+/*
+ * Per-frame GL call counters, published as datarefs and a rolling CSV log
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifdef FLIR_GL_STATS
+
+#include <string.h>
+#include <stdio.h>
+
+#include "XPLMDataAccess.h"
+#include "XPLMUtilities.h"
+#include "XPLMProcessing.h"
+#include "FLIR_GLStats.h"
+
+#define GL_STATS_HISTORY 600
+#define GL_STATS_LOG_INTERVAL 10.0f
+
+enum {
+    GL_STAT_DRAW_CALLS,
+    GL_STAT_VERTICES,
+    GL_STAT_STATE_CHANGES,
+    GL_STAT_BLEND_DEPTH_TOGGLES,
+    GL_STAT_READBACKS,
+    GL_STAT_READBACK_BYTES,
+    GL_STAT_UPLOAD_BYTES,
+    GL_STAT_COUNT
+};
+
+static const char* gStatNames[GL_STAT_COUNT] = {
+    "flir/gl/draw_calls",
+    "flir/gl/vertices",
+    "flir/gl/state_changes",
+    "flir/gl/blend_depth_toggles",
+    "flir/gl/readbacks",
+    "flir/gl/readback_bytes",
+    "flir/gl/upload_bytes"
+};
+
+static FLIRGLFrameStats gCurrent;
+static FLIRGLFrameStats gLastFrame;
+static FLIRGLFrameStats gHistory[GL_STATS_HISTORY];
+static int gHistoryHead = 0;
+static int gHistoryCount = 0;
+static int gFrameNumber = 0;
+static float gLastLogTime = 0.0f;
+static char gLogPath[512];
+static XPLMDataRef gStatRefs[GL_STAT_COUNT];
+static int gLastBlend = -1;
+static int gLastDepthTest = -1;
+
+static int StatValue(const FLIRGLFrameStats* stats, int stat)
+{
+    switch (stat) {
+        case GL_STAT_DRAW_CALLS: return stats->drawCalls;
+        case GL_STAT_VERTICES: return stats->vertices;
+        case GL_STAT_STATE_CHANGES: return stats->stateChanges;
+        case GL_STAT_BLEND_DEPTH_TOGGLES: return stats->blendDepthToggles;
+        case GL_STAT_READBACKS: return stats->readbacks;
+        case GL_STAT_READBACK_BYTES: return stats->readbackBytes;
+        case GL_STAT_UPLOAD_BYTES: return stats->uploadBytes;
+        default: return 0;
+    }
+}
+
+static int GetStatCallback(void* inRefcon)
+{
+    return StatValue(&gLastFrame, (int)(ptrdiff_t)inRefcon);
+}
+
+// Bytes per pixel for the client formats the plugin actually passes to GL
+static int PixelBytes(GLenum format, GLenum type)
+{
+    int components;
+    switch (format) {
+        case GL_RGBA: components = 4; break;
+        case GL_RGB: components = 3; break;
+        case GL_LUMINANCE_ALPHA: components = 2; break;
+        default: components = 1; break;
+    }
+    return type == GL_FLOAT ? components * 4 : components;
+}
+
+static void WriteLog()
+{
+    FILE* file = fopen(gLogPath, "w");
+    if (!file) return;
+
+    fprintf(file, "frame,draw_calls,vertices,state_changes,blend_depth_toggles,readbacks,readback_bytes,upload_bytes\n");
+
+    // Oldest frame first
+    int first = gHistoryHead - gHistoryCount;
+    if (first < 0) first += GL_STATS_HISTORY;
+    for (int i = 0; i < gHistoryCount; i++) {
+        const FLIRGLFrameStats* stats = &gHistory[(first + i) % GL_STATS_HISTORY];
+        fprintf(file, "%d", gFrameNumber - gHistoryCount + i + 1);
+        for (int stat = 0; stat < GL_STAT_COUNT; stat++) {
+            fprintf(file, ",%d", StatValue(stats, stat));
+        }
+        fprintf(file, "\n");
+    }
+    fclose(file);
+}
+
+void InitializeGLStats()
+{
+    memset(&gCurrent, 0, sizeof(gCurrent));
+    memset(&gLastFrame, 0, sizeof(gLastFrame));
+    gHistoryHead = 0;
+    gHistoryCount = 0;
+    gFrameNumber = 0;
+    gLastBlend = -1;
+    gLastDepthTest = -1;
+    gLastLogTime = XPLMGetElapsedTime();
+
+    char systemPath[512];
+    XPLMGetSystemPath(systemPath);
+    snprintf(gLogPath, sizeof(gLogPath), "%sOutput%sFLIR_GLStats.csv", systemPath, XPLMGetDirectorySeparator());
+
+    for (int stat = 0; stat < GL_STAT_COUNT; stat++) {
+        gStatRefs[stat] = XPLMRegisterDataAccessor(gStatNames[stat], xplmType_Int, 0,
+                                                   GetStatCallback, NULL,
+                                                   NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                                   (void*)(ptrdiff_t)stat, NULL);
+    }
+
+    XPLMDebugString("FLIR: GL call instrumentation enabled\n");
+}
+
+void CleanupGLStats()
+{
+    if (gHistoryCount > 0) WriteLog();
+
+    for (int stat = 0; stat < GL_STAT_COUNT; stat++) {
+        if (gStatRefs[stat]) {
+            XPLMUnregisterDataAccessor(gStatRefs[stat]);
+            gStatRefs[stat] = NULL;
+        }
+    }
+}
+
+void EndGLStatsFrame()
+{
+    gLastFrame = gCurrent;
+    memset(&gCurrent, 0, sizeof(gCurrent));
+
+    gHistory[gHistoryHead] = gLastFrame;
+    gHistoryHead = (gHistoryHead + 1) % GL_STATS_HISTORY;
+    if (gHistoryCount < GL_STATS_HISTORY) gHistoryCount++;
+    gFrameNumber++;
+
+    float now = XPLMGetElapsedTime();
+    if (now - gLastLogTime >= GL_STATS_LOG_INTERVAL) {
+        gLastLogTime = now;
+        WriteLog();
+    }
+}
+
+void GetGLStatsFrame(FLIRGLFrameStats* outStats)
+{
+    *outStats = gLastFrame;
+}
+
+void CountGLDraw(int vertices)
+{
+    gCurrent.drawCalls++;
+    gCurrent.vertices += vertices;
+}
+
+void CountGLVertex()
+{
+    gCurrent.vertices++;
+}
+
+void CountGLState(GLenum capability)
+{
+    gCurrent.stateChanges++;
+    if (capability == GL_BLEND || capability == GL_DEPTH_TEST) {
+        gCurrent.blendDepthToggles++;
+    }
+}
+
+// Blending and depth testing are only switched through XPLMSetGraphicsState,
+// so toggles are changes against the last state it was given
+void CountGLGraphicsState(int blend, int depthTest)
+{
+    gCurrent.stateChanges++;
+    if (blend != gLastBlend) gCurrent.blendDepthToggles++;
+    if (depthTest != gLastDepthTest) gCurrent.blendDepthToggles++;
+    gLastBlend = blend;
+    gLastDepthTest = depthTest;
+}
+
+void CountGLReadback(int width, int height, GLenum format, GLenum type)
+{
+    gCurrent.readbacks++;
+    gCurrent.readbackBytes += width * height * PixelBytes(format, type);
+}
+
+void CountGLUpload(int width, int height, GLenum format, GLenum type)
+{
+    gCurrent.uploadBytes += width * height * PixelBytes(format, type);
+}
+
+void CountGLUploadBytes(long bytes)
+{
+    gCurrent.uploadBytes += (int)bytes;
+}
+
+#endif // FLIR_GL_STATS
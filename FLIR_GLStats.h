@@ -0,0 +1,112 @@
+/*
+ * Header file for the optional GL call counters (build with make GL_STATS=1)
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_GLSTATS_H
+#define FLIR_GLSTATS_H
+
+// Include after every GL/XPLM header in a translation unit. With FLIR_GL_STATS
+// defined, the GL and XPLM drawing calls below are wrapped by macros that
+// count them before making the real call; otherwise this header defines
+// nothing but empty hooks and the instrumentation compiles out entirely.
+
+#ifdef FLIR_GL_STATS
+
+#include "FLIR_GLExt.h"
+
+// Counters for one frame, from the start of the draw callback to EndGLStatsFrame
+typedef struct {
+    int drawCalls;          // glBegin/glEnd blocks, glDrawArrays, glCallList, glDrawPixels
+    int vertices;
+    int stateChanges;       // Enable/disable, blend funcs, widths, binds, programs, XPLM state
+    int blendDepthToggles;  // The GL_BLEND and GL_DEPTH_TEST subset of the above
+    int readbacks;          // glReadPixels and framebuffer-to-texture copies
+    int readbackBytes;
+    int uploadBytes;        // Texture images, buffer data and glDrawPixels
+} FLIRGLFrameStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void InitializeGLStats();
+void CleanupGLStats();
+void EndGLStatsFrame();
+void GetGLStatsFrame(FLIRGLFrameStats* outStats);
+
+void CountGLDraw(int vertices);
+void CountGLVertex();
+void CountGLState(GLenum capability);
+void CountGLGraphicsState(int blend, int depthTest);
+void CountGLReadback(int width, int height, GLenum format, GLenum type);
+void CountGLUpload(int width, int height, GLenum format, GLenum type);
+void CountGLUploadBytes(long bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define glBegin(mode) (CountGLDraw(0), glBegin(mode))
+#define glVertex2f(x, y) (CountGLVertex(), glVertex2f(x, y))
+#define glDrawArrays(mode, first, count) (CountGLDraw(count), glDrawArrays(mode, first, count))
+#define glCallList(list) (CountGLDraw(0), glCallList(list))
+#define glDrawPixels(w, h, format, type, pixels) \
+    (CountGLDraw(0), CountGLUpload(w, h, format, type), glDrawPixels(w, h, format, type, pixels))
+
+#define glEnable(cap) (CountGLState(cap), glEnable(cap))
+#define glDisable(cap) (CountGLState(cap), glDisable(cap))
+#define glBlendFunc(s, d) (CountGLState(0), glBlendFunc(s, d))
+#define glLineWidth(w) (CountGLState(0), glLineWidth(w))
+#define glPointSize(s) (CountGLState(0), glPointSize(s))
+#define XPLMSetGraphicsState(fog, units, light, alphaTest, blend, depthTest, depthWrite) \
+    (CountGLGraphicsState(blend, depthTest), \
+     XPLMSetGraphicsState(fog, units, light, alphaTest, blend, depthTest, depthWrite))
+#define XPLMBindTexture2d(texture, unit) (CountGLState(0), XPLMBindTexture2d(texture, unit))
+#define flirBindBuffer(target, buffer) (CountGLState(0), flirBindBuffer(target, buffer))
+#define flirUseProgram(program) (CountGLState(0), flirUseProgram(program))
+
+#define glReadPixels(x, y, w, h, format, type, pixels) \
+    (CountGLReadback(w, h, format, type), glReadPixels(x, y, w, h, format, type, pixels))
+// Framebuffer to texture stays on the GPU but moves a full screen of pixels
+#define glCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, w, h) \
+    (CountGLReadback(w, h, GL_RGBA, GL_UNSIGNED_BYTE), \
+     glCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, w, h))
+#define glTexImage2D(target, level, internal, w, h, border, format, type, pixels) \
+    (CountGLUpload((pixels) ? (w) : 0, h, format, type), \
+     glTexImage2D(target, level, internal, w, h, border, format, type, pixels))
+#define glTexSubImage2D(target, level, x, y, w, h, format, type, pixels) \
+    (CountGLUpload(w, h, format, type), glTexSubImage2D(target, level, x, y, w, h, format, type, pixels))
+#define flirBufferData(target, size, data, usage) \
+    (CountGLUploadBytes((data) ? (long)(size) : 0), flirBufferData(target, size, data, usage))
+
+#else
+
+#define InitializeGLStats() ((void)0)
+#define CleanupGLStats() ((void)0)
+#define EndGLStatsFrame() ((void)0)
+
+#endif // FLIR_GL_STATS
+
+#endif // FLIR_GLSTATS_H
@@ -0,0 +1,262 @@
+/*
+ * Fixed-timestep turret gimbal model with rate and acceleration limits, keyhole handling and stabilisation
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <math.h>
+
+#include "XPLMProcessing.h"
+#include "FLIR_Gimbal.h"
+#include "FLIR_SimState.h"
+#include "FLIR_Mount.h"
+#include "FLIR_Optics.h"
+#include "FLIR_Input.h"
+
+#define GIMBAL_STEP (1.0f / 120.0f)
+#define GIMBAL_MAX_STEPS 12         // Drop time beyond 0.1 s rather than spiral after a stall
+
+typedef struct {
+    float angle;
+    float rate;
+    float maxRate;                  // Degrees per second
+    float maxAccel;                 // Degrees per second squared
+    float minAngle, maxAngle;
+    int wraps;                      // Continuous rotation, angle kept in [-180, 180)
+} GimbalAxis;
+
+static XPLMFlightLoopID gGimbalLoop = NULL;
+static GimbalAxis gPan;
+static GimbalAxis gTilt;
+static float gPreviousPan = 0.0f;
+static float gPreviousTilt = 0.0f;
+static float gAccumulator = 0.0f;
+
+static float gTargetPan = 0.0f;
+static float gTargetTilt = -15.0f;
+static float gTargetDir[3] = { 0.0f, 0.0f, -1.0f };    // Stabilised line of sight, local axes
+static int gTargetDirValid = 0;
+static float gPendingPan = 0.0f;
+static float gPendingTilt = 0.0f;
+static int gStabilized = 1;
+
+// Near nadir the pan axis stops mapping to image motion, so pan holds
+// instead of chasing a target azimuth that swings wildly
+static float gKeyholeTilt = -87.0f;
+
+static float WrapAngle(float angle)
+{
+    while (angle >= 180.0f) angle -= 360.0f;
+    while (angle < -180.0f) angle += 360.0f;
+    return angle;
+}
+
+static float ClampTilt(float tilt)
+{
+    if (tilt > gTilt.maxAngle) return gTilt.maxAngle;
+    if (tilt < gTilt.minAngle) return gTilt.minAngle;
+    return tilt;
+}
+
+static void StepAxis(GimbalAxis* axis, float target, float dt)
+{
+    float error = target - axis->angle;
+    if (axis->wraps) error = WrapAngle(error);
+
+    // Fastest rate that can still stop on the target, and never more than
+    // closes the error in one step
+    float distance = fabsf(error);
+    float desired = sqrtf(2.0f * axis->maxAccel * distance);
+    if (desired > axis->maxRate) desired = axis->maxRate;
+    if (desired > distance / dt) desired = distance / dt;
+    if (error < 0.0f) desired = -desired;
+
+    float maxChange = axis->maxAccel * dt;
+    float change = desired - axis->rate;
+    if (change > maxChange) change = maxChange;
+    if (change < -maxChange) change = -maxChange;
+    axis->rate += change;
+
+    axis->angle += axis->rate * dt;
+    if (axis->wraps) {
+        axis->angle = WrapAngle(axis->angle);
+    } else if (axis->angle > axis->maxAngle) {
+        axis->angle = axis->maxAngle;
+        axis->rate = 0.0f;
+    } else if (axis->angle < axis->minAngle) {
+        axis->angle = axis->minAngle;
+        axis->rate = 0.0f;
+    }
+}
+
+// Re-derives body angles from the stabilised direction so the airframe's
+// rotation is taken out
+static void RestoreStabilizedTarget()
+{
+    // The snapshot loop may not have run yet this frame; converting with last
+    // frame's attitude would jitter the image against the camera callback
+    if (!GetSimState()->valid || GetSimStateAge() != 0) {
+        RefreshSimState();
+    }
+    const FLIRMount* mount = UpdateMount(GetSimState());
+
+    if (gStabilized && mount->valid && gTargetDirValid && gTilt.angle > gKeyholeTilt) {
+        LocalDirectionToGimbal(gTargetDir, &gTargetPan, &gTargetTilt);
+    }
+    gTargetTilt = ClampTilt(gTargetTilt);
+}
+
+static void StoreTargetDirection()
+{
+    const FLIRMount* mount = GetMount();
+    if (!mount->valid) return;
+
+    FLIRMountPose pose;
+    ComputeMountPose(gTargetPan, gTargetTilt, &pose);
+    memcpy(gTargetDir, pose.forward, sizeof(gTargetDir));
+    gTargetDirValid = 1;
+}
+
+static float GimbalLoopCallback(float inElapsedSinceLastCall, float inElapsedTimeSinceLastFlightLoop,
+                                int inCounter, void* inRefcon)
+{
+    SampleInput();
+    float inputPan, inputTilt;
+    TakeInputSlew(&inputPan, &inputTilt);
+    gPendingPan += inputPan;
+    gPendingTilt += inputTilt;
+
+    RestoreStabilizedTarget();
+
+    gAccumulator += inElapsedSinceLastCall;
+    if (gAccumulator > GIMBAL_STEP * GIMBAL_MAX_STEPS) {
+        gAccumulator = GIMBAL_STEP * GIMBAL_MAX_STEPS;
+    }
+
+    // The frame's slew becomes a constant rate command across its fixed
+    // steps, so the command trajectory is the same at any frame rate. With
+    // no step due this frame it waits for the next one.
+    int steps = (int)(gAccumulator / GIMBAL_STEP);
+    float panStep = 0.0f;
+    float tiltStep = 0.0f;
+    if (steps > 0) {
+        panStep = gPendingPan / steps;
+        tiltStep = gPendingTilt / steps;
+        gPendingPan = 0.0f;
+        gPendingTilt = 0.0f;
+    }
+
+    for (int step = 0; step < steps; step++) {
+        gPreviousPan = gPan.angle;
+        gPreviousTilt = gTilt.angle;
+
+        gTargetPan = WrapAngle(gTargetPan + panStep);
+        gTargetTilt = ClampTilt(gTargetTilt + tiltStep);
+
+        float panTarget = gTilt.angle <= gKeyholeTilt ? gPan.angle : gTargetPan;
+        StepAxis(&gPan, panTarget, GIMBAL_STEP);
+        StepAxis(&gTilt, gTargetTilt, GIMBAL_STEP);
+        StepOptics(GIMBAL_STEP);
+    }
+    gAccumulator -= steps * GIMBAL_STEP;
+
+    StoreTargetDirection();
+
+    return -1.0f; // Every sim frame, stepping as many fixed steps as have elapsed
+}
+
+void InitializeGimbal()
+{
+    memset(&gPan, 0, sizeof(gPan));
+    gPan.maxRate = 90.0f;
+    gPan.maxAccel = 360.0f;
+    gPan.minAngle = -180.0f;
+    gPan.maxAngle = 180.0f;
+    gPan.wraps = 1;
+
+    memset(&gTilt, 0, sizeof(gTilt));
+    gTilt.maxRate = 60.0f;
+    gTilt.maxAccel = 240.0f;
+    gTilt.minAngle = -90.0f;
+    gTilt.maxAngle = 45.0f;
+
+    ResetGimbal(0.0f, -15.0f);
+
+    XPLMCreateFlightLoop_t params;
+    params.structSize = sizeof(params);
+    params.phase = xplm_FlightLoop_Phase_AfterFlightModel;
+    params.callbackFunc = GimbalLoopCallback;
+    params.refcon = NULL;
+
+    gGimbalLoop = XPLMCreateFlightLoop(&params);
+    XPLMScheduleFlightLoop(gGimbalLoop, -1.0f, 1);
+}
+
+void CleanupGimbal()
+{
+    if (gGimbalLoop) {
+        XPLMDestroyFlightLoop(gGimbalLoop);
+        gGimbalLoop = NULL;
+    }
+}
+
+void SetGimbalTarget(float pan, float tilt)
+{
+    gTargetPan = WrapAngle(pan);
+    gTargetTilt = ClampTilt(tilt);
+    gPendingPan = 0.0f;
+    gPendingTilt = 0.0f;
+    gTargetDirValid = 0;
+}
+
+void ResetGimbal(float pan, float tilt)
+{
+    SetGimbalTarget(pan, tilt);
+    gPan.angle = gTargetPan;
+    gPan.rate = 0.0f;
+    gTilt.angle = gTargetTilt;
+    gTilt.rate = 0.0f;
+    gPreviousPan = gPan.angle;
+    gPreviousTilt = gTilt.angle;
+    gAccumulator = 0.0f;
+}
+
+void SetGimbalStabilization(int enabled)
+{
+    gStabilized = enabled;
+    gTargetDirValid = 0;
+}
+
+int IsGimbalStabilized()
+{
+    return gStabilized;
+}
+
+void GetGimbalAngles(float* outPan, float* outTilt)
+{
+    float alpha = gAccumulator / GIMBAL_STEP;
+
+    *outPan = WrapAngle(gPreviousPan + WrapAngle(gPan.angle - gPreviousPan) * alpha);
+    *outTilt = gPreviousTilt + (gTilt.angle - gPreviousTilt) * alpha;
+}
@@ -0,0 +1,54 @@
+/*
+ * Header file for the fixed-timestep turret gimbal model
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_GIMBAL_H
+#define FLIR_GIMBAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void InitializeGimbal();
+void CleanupGimbal();
+
+// Pointer input is pulled from FLIR_Input each loop and spread over the
+// next fixed steps; there is no direct slew entry point
+void SetGimbalTarget(float pan, float tilt);
+void ResetGimbal(float pan, float tilt);
+
+// Stabilised: the commanded line of sight holds still in the world while
+// the airframe rotates under it. Otherwise it is fixed to the body.
+void SetGimbalStabilization(int enabled);
+int IsGimbalStabilized();
+
+// Interpolated between the last two fixed steps for the current frame
+void GetGimbalAngles(float* outPan, float* outTilt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_GIMBAL_H
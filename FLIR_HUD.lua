@@ -26,8 +26,28 @@ flir_start_time = flir_start_time or os.time()
 flir_hud_enabled = flir_hud_enabled or true
 flir_last_view_type = 0
 
+-- Bound once at load; FlyWithLua refreshes these globals every frame, so the
+-- draw callback reads one consistent snapshot instead of resolving datarefs
+DataRef("flir_view_type", "sim/graphics/view/view_type")
+DataRef("flir_zulu_time", "sim/time/zulu_time_sec")
+DataRef("flir_latitude", "sim/flightmodel/position/latitude")
+DataRef("flir_longitude", "sim/flightmodel/position/longitude")
+DataRef("flir_elevation", "sim/flightmodel/position/elevation")
+DataRef("flir_ground_speed", "sim/flightmodel/position/groundspeed")
+DataRef("flir_heading", "sim/flightmodel/position/psi")
+
+-- Rangefinder readout published by the FLIR plugin, when it is loaded
+flir_has_rangefinder = XPLMFindDataRef("flir/rangefinder/valid") ~= nil
+if flir_has_rangefinder then
+    DataRef("flir_range_valid", "flir/rangefinder/valid")
+    DataRef("flir_slant_range", "flir/rangefinder/slant_range_m")
+    DataRef("flir_target_latitude", "flir/rangefinder/target_latitude")
+    DataRef("flir_target_longitude", "flir/rangefinder/target_longitude")
+    DataRef("flir_target_elevation", "flir/rangefinder/target_elevation_m")
+end
+
 function draw_flir_hud()
-    local view_type = XPLMGetDatai(XPLMFindDataRef("sim/graphics/view/view_type"))
+    local view_type = flir_view_type
     
     if view_type == 1026 and flir_last_view_type ~= 1026 then
         if flir_hud_enabled then
@@ -44,12 +64,12 @@ function draw_flir_hud()
         return
     end
     
-    local zulu_time = XPLMGetDataf(XPLMFindDataRef("sim/time/zulu_time_sec"))
-    local latitude = XPLMGetDataf(XPLMFindDataRef("sim/flightmodel/position/latitude"))
-    local longitude = XPLMGetDataf(XPLMFindDataRef("sim/flightmodel/position/longitude"))
-    local altitude_msl = XPLMGetDataf(XPLMFindDataRef("sim/flightmodel/position/elevation"))
-    local ground_speed = XPLMGetDataf(XPLMFindDataRef("sim/flightmodel/position/groundspeed"))
-    local heading = XPLMGetDataf(XPLMFindDataRef("sim/flightmodel/position/psi"))
+    local zulu_time = flir_zulu_time
+    local latitude = flir_latitude
+    local longitude = flir_longitude
+    local altitude_msl = flir_elevation
+    local ground_speed = flir_ground_speed
+    local heading = flir_heading
     
     local hours = math.floor(zulu_time / 3600) % 24
     local minutes = math.floor((zulu_time % 3600) / 60)
@@ -74,7 +94,15 @@ function draw_flir_hud()
     local mission_line = string.format("REC: %02d:%02d:%02d", mission_hours, mission_mins, mission_secs)
     graphics.draw_string(SCREEN_WIDTH - 180, SCREEN_HEIGHT - 25, mission_line, "large")
     
-    graphics.draw_string(SCREEN_WIDTH - 180, SCREEN_HEIGHT - 50, "TGT: SCANNING", "large")
+    if flir_has_rangefinder and flir_range_valid == 1 then
+        local range_line = string.format("TGT: %05dm", math.floor(flir_slant_range))
+        graphics.draw_string(SCREEN_WIDTH - 180, SCREEN_HEIGHT - 50, range_line, "large")
+        local target_line = string.format("%.4f° %.4f°  %dft", flir_target_latitude, flir_target_longitude,
+                                          math.floor(flir_target_elevation * 3.28084))
+        graphics.draw_string(SCREEN_WIDTH - 300, SCREEN_HEIGHT - 75, target_line, "large")
+    else
+        graphics.draw_string(SCREEN_WIDTH - 180, SCREEN_HEIGHT - 50, "TGT: SCANNING", "large")
+    end
     
     graphics.draw_string(20, 80, "◆ SYS: NOMINAL  STAB: ON  IR: WHT", "large")
     graphics.draw_string(20, 105, "● ZOOM: 1.0x  FOV: WIDE  FOCUS: AUTO", "large")
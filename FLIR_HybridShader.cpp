@@ -0,0 +1,160 @@
+/*
+ * Single-pass hybrid modes: the frame redrawn through a per-band transfer table
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "XPLMGraphics.h"
+#include "XPLMUtilities.h"
+#include "FLIR_GLExt.h"
+#include "FLIR_HybridShader.h"
+#include "FLIR_GLStats.h"
+
+// Texture units
+#define UNIT_SCENE 0
+#define UNIT_TRANSFER 1
+#define UNIT_COUNT 2
+
+// Each channel indexes its own column, the band comes from the overlay's
+// top-down y. Both lookups hit texel centres, so nearest sampling is exact.
+static const char* gFragmentSource =
+    "uniform sampler2D scene;\n"
+    "uniform sampler2D transfer;\n"
+    "uniform vec2 screenSize;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 level = floor(texture2D(scene, gl_FragCoord.xy / screenSize).rgb * 255.0 + 0.5);\n"
+    "    float band = floor((screenSize.y - gl_FragCoord.y) * TRANSFER_ROWS / screenSize.y);\n"
+    "    float v = (band + 0.5) / TRANSFER_ROWS;\n"
+    "    vec3 u = (level + 0.5) / TRANSFER_LEVELS;\n"
+    "    gl_FragColor = vec4(texture2D(transfer, vec2(u.r, v)).r,\n"
+    "                        texture2D(transfer, vec2(u.g, v)).g,\n"
+    "                        texture2D(transfer, vec2(u.b, v)).b, 1.0);\n"
+    "}\n";
+
+static int gShaderFailed = 0;
+static GLuint gProgram = 0;
+static GLint gScreenSizeUniform = -1;
+static int gTextures[UNIT_COUNT];
+static int gTexturesReady = 0;
+static int gSceneWidth = 0;
+static int gSceneHeight = 0;
+static int gUploadedTransfer = -1;
+
+static int BuildProgram()
+{
+    char prelude[256];
+    snprintf(prelude, sizeof(prelude),
+             "#version 120\n#define TRANSFER_LEVELS %d.0\n#define TRANSFER_ROWS %d.0\n",
+             HYBRID_TRANSFER_LEVELS, HYBRID_TRANSFER_ROWS);
+
+    gProgram = BuildFragmentProgram(prelude, gFragmentSource, "hybrid");
+    if (!gProgram) return 0;
+
+    flirUseProgram(gProgram);
+    flirUniform1i(flirGetUniformLocation(gProgram, "scene"), UNIT_SCENE);
+    flirUniform1i(flirGetUniformLocation(gProgram, "transfer"), UNIT_TRANSFER);
+    gScreenSizeUniform = flirGetUniformLocation(gProgram, "screenSize");
+    flirUseProgram(0);
+
+    XPLMDebugString("FLIR: single-pass hybrid modes active\n");
+    return 1;
+}
+
+int RenderHybridShader(int screenWidth, int screenHeight, const unsigned char* transfer, int transferVersion)
+{
+    if (gShaderFailed) return 0;
+
+    if (!gProgram) {
+        InitializeGLExtensions();
+        if (!HasShaders() || !BuildProgram()) {
+            gShaderFailed = 1;
+            return 0;
+        }
+    }
+
+    while (glGetError() != GL_NO_ERROR) { }
+
+    XPLMSetGraphicsState(0, UNIT_COUNT, 0, 0, 0, 0, 0);
+
+    int allocate = !gTexturesReady;
+    if (!gTexturesReady) {
+        XPLMGenerateTextureNumbers(gTextures, UNIT_COUNT);
+        gTexturesReady = 1;
+    }
+
+    // Device-side copy of the frame, the transfer table only when it changed
+    BindLookupTexture(gTextures[UNIT_SCENE], allocate);
+    if (gSceneWidth != screenWidth || gSceneHeight != screenHeight) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, screenWidth, screenHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        gSceneWidth = screenWidth;
+        gSceneHeight = screenHeight;
+    }
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, screenWidth, screenHeight);
+
+    BindLookupTexture(gTextures[UNIT_TRANSFER], allocate);
+    if (gUploadedTransfer != transferVersion) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, HYBRID_TRANSFER_LEVELS, HYBRID_TRANSFER_ROWS, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, transfer);
+        gUploadedTransfer = transferVersion;
+    }
+
+    XPLMBindTexture2d(gTextures[UNIT_TRANSFER], UNIT_TRANSFER);
+    XPLMBindTexture2d(gTextures[UNIT_SCENE], UNIT_SCENE);
+
+    flirUseProgram(gProgram);
+    flirUniform2f(gScreenSizeUniform, (float)screenWidth, (float)screenHeight);
+
+    DrawScreenQuad(screenWidth, screenHeight);
+
+    flirUseProgram(0);
+    XPLMSetGraphicsState(0, 0, 0, 0, 1, 0, 0);
+
+    if (glGetError() != GL_NO_ERROR) {
+        XPLMDebugString("FLIR: hybrid shader failed, falling back to overlay passes\n");
+        ReleaseHybridShader();
+        gShaderFailed = 1;
+        return 0;
+    }
+    return 1;
+}
+
+void ReleaseHybridShader()
+{
+    if (gProgram && flirDeleteProgram) {
+        flirDeleteProgram(gProgram);
+    }
+    if (gTexturesReady) {
+        GLuint textures[UNIT_COUNT];
+        for (int i = 0; i < UNIT_COUNT; i++) textures[i] = (GLuint)gTextures[i];
+        glDeleteTextures(UNIT_COUNT, textures);
+    }
+    gProgram = 0;
+    gTexturesReady = 0;
+    gSceneWidth = gSceneHeight = 0;
+    gUploadedTransfer = -1;
+}
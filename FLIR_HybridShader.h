@@ -0,0 +1,50 @@
+/*
+ * Header file for the single-pass hybrid look-up shader
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_HYBRIDSHADER_H
+#define FLIR_HYBRIDSHADER_H
+
+// Transfer table for the hybrid modes: one RGBA row per horizontal band of
+// the screen (row 0 at the top), one column per input level. Entry [row][x]
+// is what the mode's overlay passes turn level x into within that band.
+#define HYBRID_TRANSFER_LEVELS 256
+#define HYBRID_TRANSFER_ROWS 256
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Copies the frame into a texture and redraws it through the transfer table
+// in one full-screen fill. Returns 0 when GLSL is unavailable or failed, so
+// the caller can fall back to drawing the overlay passes.
+int RenderHybridShader(int screenWidth, int screenHeight, const unsigned char* transfer, int transferVersion);
+void ReleaseHybridShader();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_HYBRIDSHADER_H
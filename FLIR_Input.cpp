@@ -0,0 +1,81 @@
+/*
+ * Pointer input accumulator: turns mouse motion into gimbal slew independent of frame rate
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "XPLMDisplay.h"
+#include "FLIR_Input.h"
+#include "FLIR_Optics.h"
+
+static int gEnabled = 0;
+static int gAnchored = 0;
+static int gLastX = 0;
+static int gLastY = 0;
+static int gPendingX = 0;           // Pixels, kept integral so nothing is lost to rounding
+static int gPendingY = 0;
+static float gSensitivity = 0.2f;   // Degrees per pixel at 1x
+
+void InitializeInput()
+{
+    gEnabled = 0;
+    ResetInput();
+}
+
+void ResetInput()
+{
+    gAnchored = 0;
+    gPendingX = 0;
+    gPendingY = 0;
+}
+
+void SetInputEnabled(int enabled)
+{
+    if (enabled && !gEnabled) ResetInput();
+    gEnabled = enabled;
+}
+
+void SampleInput()
+{
+    int x, y;
+    XPLMGetMouseLocationGlobal(&x, &y);
+
+    if (gAnchored && gEnabled) {
+        gPendingX += x - gLastX;
+        gPendingY += y - gLastY;
+    }
+    gLastX = x;
+    gLastY = y;
+    gAnchored = 1;
+}
+
+void TakeInputSlew(float* outPan, float* outTilt)
+{
+    float scale = gSensitivity * GetOpticsSensitivity();
+
+    // Pushing the mouse forward tilts the turret down
+    *outPan = gPendingX * scale;
+    *outTilt = -gPendingY * scale;
+    gPendingX = 0;
+    gPendingY = 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * Belly-mount transform: one body-to-local rotation per sim frame, shared by camera placement and projection
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "FLIR_Mount.h"
+
+#define DEG_TO_RAD ((float)M_PI / 180.0f)
+#define RAD_TO_DEG (180.0f / (float)M_PI)
+
+#define MOUNT_MAX_LEAD 0.1f         // Never extrapolate further than this, seconds
+
+static FLIRMount gMount;
+static float gPredictionFrames = 1.0f;
+
+void InitializeMount()
+{
+    memset(&gMount, 0, sizeof(gMount));
+    gMount.cycle = -1;
+
+    // Turret 5 m below and 3 m ahead of the CG
+    SetMountLeverArm(0.0f, -5.0f, -3.0f);
+}
+
+void SetMountLeverArm(float right, float up, float aft)
+{
+    gMount.leverArm[0] = right;
+    gMount.leverArm[1] = up;
+    gMount.leverArm[2] = aft;
+    gMount.cycle = -1;
+}
+
+void SetMountPrediction(float frames)
+{
+    gPredictionFrames = frames > 0.0f ? frames : 0.0f;
+    gMount.cycle = -1;
+}
+
+float GetMountPrediction()
+{
+    return gPredictionFrames;
+}
+
+static void Rotate(const float m[3][3], const float in[3], float out[3])
+{
+    out[0] = m[0][0] * in[0] + m[0][1] * in[1] + m[0][2] * in[2];
+    out[1] = m[1][0] * in[0] + m[1][1] * in[1] + m[1][2] * in[2];
+    out[2] = m[2][0] * in[0] + m[2][1] * in[1] + m[2][2] * in[2];
+}
+
+// The matrix is orthonormal, so its transpose is the inverse
+static void RotateTransposed(const float m[3][3], const float in[3], float out[3])
+{
+    out[0] = m[0][0] * in[0] + m[1][0] * in[1] + m[2][0] * in[2];
+    out[1] = m[0][1] * in[0] + m[1][1] * in[1] + m[2][1] * in[2];
+    out[2] = m[0][2] * in[0] + m[1][2] * in[1] + m[2][2] * in[2];
+}
+
+const FLIRMount* UpdateMount(const FLIRSimState* state)
+{
+    if (!state->valid) {
+        gMount.valid = 0;
+        return &gMount;
+    }
+    if (gMount.valid && gMount.cycle == state->cycle) {
+        return &gMount;
+    }
+
+    float lead = gPredictionFrames * state->frameTime;
+    if (lead > MOUNT_MAX_LEAD) lead = MOUNT_MAX_LEAD;
+
+    float heading = state->heading;
+    float pitch = state->pitch;
+    float roll = state->roll;
+    if (lead > 0.0f) {
+        // Body rates P, Q, R to Euler angle rates, held constant over the lead
+        float sinRoll = sinf(roll * DEG_TO_RAD), cosRoll = cosf(roll * DEG_TO_RAD);
+        float cosPitch = cosf(pitch * DEG_TO_RAD);
+        if (cosPitch < 0.05f) cosPitch = 0.05f;
+        float turn = state->pitchRate * sinRoll + state->yawRate * cosRoll;
+
+        roll += (state->rollRate + turn * tanf(pitch * DEG_TO_RAD)) * lead;
+        pitch += (state->pitchRate * cosRoll - state->yawRate * sinRoll) * lead;
+        heading += turn / cosPitch * lead;
+    }
+
+    // Local axes: +X east, +Y up, -Z north. Heading turns clockwise from
+    // north, pitch raises the nose, positive roll drops the right wing.
+    float sh = sinf(heading * DEG_TO_RAD), ch = cosf(heading * DEG_TO_RAD);
+    float sp = sinf(pitch * DEG_TO_RAD), cp = cosf(pitch * DEG_TO_RAD);
+    float sr = sinf(roll * DEG_TO_RAD), cr = cosf(roll * DEG_TO_RAD);
+
+    float forward[3] = { sh * cp, sp, -ch * cp };
+    float levelRight[3] = { ch, 0.0f, sh };
+    float levelUp[3] = { -sh * sp, cp, ch * sp };
+
+    // Columns are the body right, up and aft axes expressed in local coordinates
+    for (int i = 0; i < 3; i++) {
+        gMount.bodyToLocal[i][0] = levelRight[i] * cr - levelUp[i] * sr;
+        gMount.bodyToLocal[i][1] = levelUp[i] * cr + levelRight[i] * sr;
+        gMount.bodyToLocal[i][2] = -forward[i];
+    }
+
+    float arm[3];
+    Rotate(gMount.bodyToLocal, gMount.leverArm, arm);
+    gMount.x = state->localX + state->velocityX * lead + arm[0];
+    gMount.y = state->localY + state->velocityY * lead + arm[1];
+    gMount.z = state->localZ + state->velocityZ * lead + arm[2];
+    gMount.lead = lead;
+
+    gMount.cycle = state->cycle;
+    gMount.valid = 1;
+    return &gMount;
+}
+
+const FLIRMount* GetMount()
+{
+    return &gMount;
+}
+
+void MountBodyToLocal(const float body[3], float outLocal[3])
+{
+    Rotate(gMount.bodyToLocal, body, outLocal);
+}
+
+void MountLocalToBody(const float local[3], float outBody[3])
+{
+    RotateTransposed(gMount.bodyToLocal, local, outBody);
+}
+
+void ComputeMountPose(float pan, float tilt, FLIRMountPose* outPose)
+{
+    float sa = sinf(pan * DEG_TO_RAD), ca = cosf(pan * DEG_TO_RAD);
+    float st = sinf(tilt * DEG_TO_RAD), ct = cosf(tilt * DEG_TO_RAD);
+
+    // Pan about the body up axis, then tilt about the turret's right axis
+    float forward[3] = { sa * ct, st, -ca * ct };
+    float right[3] = { ca, 0.0f, sa };
+    float up[3] = { -sa * st, ct, ca * st };
+
+    Rotate(gMount.bodyToLocal, forward, outPose->forward);
+    Rotate(gMount.bodyToLocal, right, outPose->right);
+    Rotate(gMount.bodyToLocal, up, outPose->up);
+
+    outPose->x = gMount.x;
+    outPose->y = gMount.y;
+    outPose->z = gMount.z;
+
+    const float* f = outPose->forward;
+    float heading = atan2f(f[0], -f[2]);
+    float pitch = asinf(f[1] > 1.0f ? 1.0f : (f[1] < -1.0f ? -1.0f : f[1]));
+
+    // Roll is the turret right axis measured against the level right axis
+    // for the same heading and pitch
+    float sh = sinf(heading), ch = cosf(heading);
+    float sp = sinf(pitch), cp = cosf(pitch);
+    const float* r = outPose->right;
+    float cosRoll = r[0] * ch + r[2] * sh;
+    float sinRoll = -(r[0] * -sh * sp + r[1] * cp + r[2] * ch * sp);
+
+    outPose->heading = heading * RAD_TO_DEG;
+    outPose->pitch = pitch * RAD_TO_DEG;
+    outPose->roll = atan2f(sinRoll, cosRoll) * RAD_TO_DEG;
+    if (outPose->heading < 0.0f) outPose->heading += 360.0f;
+}
+
+void LocalDirectionToGimbal(const float localDir[3], float* outPan, float* outTilt)
+{
+    float body[3];
+    RotateTransposed(gMount.bodyToLocal, localDir, body);
+
+    float horizontal = sqrtf(body[0] * body[0] + body[2] * body[2]);
+    *outPan = atan2f(body[0], -body[2]) * RAD_TO_DEG;
+    *outTilt = atan2f(body[1], horizontal) * RAD_TO_DEG;
+}
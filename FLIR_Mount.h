@@ -0,0 +1,78 @@
+/*
+ * Header file for the belly-mount transform between aircraft body axes and local coordinates
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_MOUNT_H
+#define FLIR_MOUNT_H
+
+#include "FLIR_SimState.h"
+
+// Body axes follow X-Plane's aircraft frame: +X right, +Y up, +Z aft
+typedef struct {
+    int valid;
+    int cycle;                  // Sim state cycle the matrix was built from
+    float bodyToLocal[3][3];    // local = bodyToLocal * body
+    float leverArm[3];          // Turret offset from the CG in body axes, meters
+    float x, y, z;              // Turret position in local OpenGL coordinates
+    float lead;                 // Seconds the pose was extrapolated ahead
+} FLIRMount;
+
+// Line of sight for one gimbal setting, everything in local coordinates
+typedef struct {
+    float x, y, z;
+    float forward[3];
+    float right[3];
+    float up[3];
+    float heading, pitch, roll;     // Degrees, as XPLMCameraPosition_t wants them
+} FLIRMountPose;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void InitializeMount();
+void SetMountLeverArm(float right, float up, float aft);
+
+// Extrapolates the aircraft pose this many frames ahead to cover display
+// latency; 0 disables prediction
+void SetMountPrediction(float frames);
+float GetMountPrediction();
+
+// Rebuilds the rotation only when the snapshot cycle changes
+const FLIRMount* UpdateMount(const FLIRSimState* state);
+const FLIRMount* GetMount();
+
+void MountBodyToLocal(const float body[3], float outLocal[3]);
+void MountLocalToBody(const float local[3], float outBody[3]);
+
+// Pan is positive right of the nose, tilt positive above the wing plane
+void ComputeMountPose(float pan, float tilt, FLIRMountPose* outPose);
+void LocalDirectionToGimbal(const float localDir[3], float* outPan, float* outTilt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_MOUNT_H
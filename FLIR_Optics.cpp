@@ -0,0 +1,161 @@
+/*
+ * Table-driven optics: discrete FOV steps per sensor with slew-limited, continuous zoom
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "XPLMUtilities.h"
+#include "XPLMProcessing.h"
+#include "FLIR_Optics.h"
+
+typedef struct {
+    float zoom;             // Magnification against the sim's field of view
+    int sensor;
+    float sensitivity;      // 1 - 0.97 * (ln zoom / ln 64)^2, floored at 3%
+} OpticsStep;
+
+static const OpticsStep gSteps[] = {
+    {  1.0f, OPTICS_SENSOR_WIDE,    1.0000f },
+    {  1.5f, OPTICS_SENSOR_WIDE,    0.9908f },
+    {  2.0f, OPTICS_SENSOR_WIDE,    0.9731f },
+    {  3.0f, OPTICS_SENSOR_MEDIUM,  0.9323f },
+    {  4.0f, OPTICS_SENSOR_MEDIUM,  0.8922f },
+    {  6.0f, OPTICS_SENSOR_MEDIUM,  0.8200f },
+    {  8.0f, OPTICS_SENSOR_MEDIUM,  0.7575f },
+    { 12.0f, OPTICS_SENSOR_NARROW,  0.6537f },
+    { 16.0f, OPTICS_SENSOR_NARROW,  0.5689f },
+    { 24.0f, OPTICS_SENSOR_NARROW,  0.4336f },
+    { 32.0f, OPTICS_SENSOR_NARROW,  0.3264f },
+    { 48.0f, OPTICS_SENSOR_DIGITAL, 0.1596f },
+    { 64.0f, OPTICS_SENSOR_DIGITAL, 0.0300f },
+};
+
+#define OPTICS_STEP_COUNT ((int)(sizeof(gSteps) / sizeof(gSteps[0])))
+#define OPTICS_SLEW_RATE 4.0f       // Magnification ratio per second
+#define OPTICS_HOLD_DELAY 0.25f     // Seconds before a held key turns continuous
+
+static const char* gSensorNames[] = { "WFOV", "MFOV", "NFOV", "DZOOM" };
+
+static float gZoom = 1.0f;
+static float gTargetZoom = 1.0f;
+static int gHoldDirection = 0;
+static float gHoldStart = 0.0f;
+static int gHoldContinuous = 0;
+
+// Slew per fixed step, cached so StepOptics never calls powf
+static float gSlewStep = 0.0f;
+static float gSlewDt = 0.0f;
+
+void InitializeOptics()
+{
+    gZoom = gSteps[0].zoom;
+    gTargetZoom = gZoom;
+    gHoldDirection = 0;
+    gHoldContinuous = 0;
+    gSlewDt = 0.0f;
+}
+
+static int StepBelow(float zoom)
+{
+    int step = 0;
+    while (step + 1 < OPTICS_STEP_COUNT && gSteps[step + 1].zoom <= zoom) step++;
+    return step;
+}
+
+void StepOptics(float dt)
+{
+    if (dt != gSlewDt) {
+        gSlewDt = dt;
+        gSlewStep = powf(OPTICS_SLEW_RATE, dt);
+    }
+
+    if (gHoldDirection != 0 && !gHoldContinuous &&
+        XPLMGetElapsedTime() - gHoldStart >= OPTICS_HOLD_DELAY) {
+        gHoldContinuous = 1;
+    }
+    if (gHoldContinuous) {
+        gTargetZoom = gHoldDirection > 0 ? gSteps[OPTICS_STEP_COUNT - 1].zoom : gSteps[0].zoom;
+    }
+
+    if (gZoom < gTargetZoom) {
+        gZoom *= gSlewStep;
+        if (gZoom > gTargetZoom) gZoom = gTargetZoom;
+    } else if (gZoom > gTargetZoom) {
+        gZoom /= gSlewStep;
+        if (gZoom < gTargetZoom) gZoom = gTargetZoom;
+    }
+}
+
+void BeginZoom(int direction)
+{
+    // Tap behaviour: the next table step beyond the current target
+    int step = StepBelow(gTargetZoom);
+    if (direction > 0) {
+        if (step + 1 < OPTICS_STEP_COUNT) gTargetZoom = gSteps[step + 1].zoom;
+    } else {
+        if (gSteps[step].zoom < gTargetZoom) gTargetZoom = gSteps[step].zoom;
+        else if (step > 0) gTargetZoom = gSteps[step - 1].zoom;
+    }
+
+    gHoldDirection = direction;
+    gHoldStart = XPLMGetElapsedTime();
+    gHoldContinuous = 0;
+}
+
+void EndZoom(int direction)
+{
+    if (gHoldDirection != direction) return;
+
+    // A continuous zoom stops where the key was released
+    if (gHoldContinuous) gTargetZoom = gZoom;
+    gHoldDirection = 0;
+    gHoldContinuous = 0;
+}
+
+float GetOpticsZoom()
+{
+    return gZoom;
+}
+
+float GetOpticsSensitivity()
+{
+    int step = StepBelow(gZoom);
+    if (step + 1 >= OPTICS_STEP_COUNT) return gSteps[step].sensitivity;
+
+    const OpticsStep* low = &gSteps[step];
+    const OpticsStep* high = &gSteps[step + 1];
+    float t = (gZoom - low->zoom) / (high->zoom - low->zoom);
+    return low->sensitivity + (high->sensitivity - low->sensitivity) * t;
+}
+
+int GetOpticsSensor()
+{
+    return gSteps[StepBelow(gZoom)].sensor;
+}
+
+const char* GetOpticsSensorName()
+{
+    return gSensorNames[GetOpticsSensor()];
+}
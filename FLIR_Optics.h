@@ -0,0 +1,60 @@
+/*
+ * Header file for the table-driven optics and zoom model
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_OPTICS_H
+#define FLIR_OPTICS_H
+
+enum {
+    OPTICS_SENSOR_WIDE = 0,
+    OPTICS_SENSOR_MEDIUM,
+    OPTICS_SENSOR_NARROW,
+    OPTICS_SENSOR_DIGITAL
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void InitializeOptics();
+
+// Advances the zoom slew; called from the gimbal's fixed step
+void StepOptics(float dt);
+
+// A tap moves one table step, holding past a short delay zooms continuously
+void BeginZoom(int direction);
+void EndZoom(int direction);
+
+float GetOpticsZoom();
+// Mouse sensitivity multiplier for the current zoom, from the table
+float GetOpticsSensitivity();
+int GetOpticsSensor();
+const char* GetOpticsSensorName();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_OPTICS_H
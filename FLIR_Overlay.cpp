@@ -0,0 +1,94 @@
+/*
+ * Overlay compositor collecting a frame's overlay geometry in draw order
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FLIR_Overlay.h"
+
+static OverlayItem gItems[OVERLAY_MAX_ITEMS];
+static int gItemCount = 0;
+static int gSequence = 0;
+static int gPassWidth = 0;
+static int gPassHeight = 0;
+
+static unsigned long long MakeSortKey(int layer, const OverlayBatch* batch, int sequence)
+{
+    unsigned long long key = (unsigned long long)layer << 56;
+    if (layer == OVERLAY_LAYER_SYMBOLOGY) {
+        // Group by texture, blend and width; sequence keeps the sort stable
+        key |= ((unsigned long long)(batch->texture & 0xFFFFFF) << 32) |
+               ((unsigned long long)(batch->blend & 0xF) << 28) |
+               ((unsigned long long)((int)(batch->size * 4.0f) & 0xFFF) << 16);
+    }
+    return key | (unsigned long long)(sequence & 0xFFFF);
+}
+
+void BeginOverlayPass(const OverlayLayout* layout)
+{
+    gItemCount = 0;
+    gSequence = 0;
+    gPassWidth = layout->width;
+    gPassHeight = layout->height;
+}
+
+void SubmitOverlayGeometry(OverlayGeometry* geometry, int layer)
+{
+    if (!geometry->built) return;
+
+    for (int i = 0; i < geometry->batchCount; i++) {
+        if (gItemCount >= OVERLAY_MAX_ITEMS) return;
+        if (geometry->batches[i].count == 0) continue;
+
+        OverlayItem* item = &gItems[gItemCount++];
+        item->geometry = geometry;
+        item->batch = i;
+        item->sortKey = MakeSortKey(layer, &geometry->batches[i], gSequence++);
+    }
+}
+
+int FinishOverlayPass(const OverlayItem** outItems, int* outWidth, int* outHeight)
+{
+    // Insertion sort, the list is short and mostly in order already
+    for (int i = 1; i < gItemCount; i++) {
+        OverlayItem item = gItems[i];
+        int j = i - 1;
+        while (j >= 0 && gItems[j].sortKey > item.sortKey) {
+            gItems[j + 1] = gItems[j];
+            j--;
+        }
+        gItems[j + 1] = item;
+    }
+
+    *outItems = gItems;
+    *outWidth = gPassWidth;
+    *outHeight = gPassHeight;
+
+    int count = gItemCount;
+    gItemCount = 0;
+    return count;
+}
@@ -0,0 +1,65 @@
+/*
+ * Header file for the overlay compositor that collects a frame's overlay geometry
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_OVERLAY_H
+#define FLIR_OVERLAY_H
+
+#include "FLIR_OverlayGeometry.h"
+#include "FLIR_OverlayLayout.h"
+
+// Layers draw in this order. Filter and effects layers keep submission
+// order because their blends do not commute; symbology is state-sorted.
+#define OVERLAY_LAYER_FILTER 0
+#define OVERLAY_LAYER_EFFECTS 1
+#define OVERLAY_LAYER_SYMBOLOGY 2
+
+#define OVERLAY_MAX_ITEMS 64
+
+// One batch of submitted geometry, in final draw order after FinishOverlayPass
+typedef struct {
+    OverlayGeometry* geometry;
+    int batch;
+    unsigned long long sortKey;
+} OverlayItem;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The pass covers the layout's screen, both backends size their output from it
+void BeginOverlayPass(const OverlayLayout* layout);
+void SubmitOverlayGeometry(OverlayGeometry* geometry, int layer);
+
+// Sorts the pass and hands it to a backend; the pass is empty afterwards.
+// EndOverlayPass (FLIR_OverlayGL.h) and RasterizeOverlayPass (FLIR_OverlayRaster.h)
+// are the two consumers.
+int FinishOverlayPass(const OverlayItem** outItems, int* outWidth, int* outHeight);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_OVERLAY_H
@@ -0,0 +1,185 @@
+/*
+ * GL-free builders of the noise, pattern and reticle overlays, shared by both overlay backends
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FLIR_OverlayContent.h"
+
+static const int gPatternSizes[OVERLAY_PATTERN_COUNT][2] = { {1, 3}, {16, 16}, {8, 8} };
+
+unsigned int HashOverlayFrame(unsigned int n)
+{
+    n ^= n >> 16;
+    n *= 0x7feb352dU;
+    n ^= n >> 15;
+    n *= 0x846ca68bU;
+    n ^= n >> 16;
+    return n;
+}
+
+// Bake the noise frames once: same dot density (one per 2000 pixels) and
+// intensity distribution as the old per-point noise, stored as intensity
+// texels so blending (i,i,i,i) over the scene is unchanged
+int BuildNoiseTextures(int* textures, float intensity)
+{
+    int texelCount = OVERLAY_NOISE_SIZE * OVERLAY_NOISE_SIZE;
+    unsigned char* texels = (unsigned char*)malloc(texelCount);
+    if (!texels) return 0;
+    
+    unsigned int seed = 0x464c4952; // Fixed seed, the look is identical every run
+    int dots = texelCount / 2000;
+    
+    for (int frame = 0; frame < OVERLAY_NOISE_FRAMES; frame++) {
+        memset(texels, 0, texelCount);
+        for (int i = 0; i < dots; i++) {
+            seed = seed * 1664525U + 1013904223U;
+            int x = (seed >> 8) % OVERLAY_NOISE_SIZE;
+            seed = seed * 1664525U + 1013904223U;
+            int y = (seed >> 8) % OVERLAY_NOISE_SIZE;
+            seed = seed * 1664525U + 1013904223U;
+            float dot = ((seed >> 8) % 100) / 100.0f * intensity;
+            texels[y * OVERLAY_NOISE_SIZE + x] = (unsigned char)(dot * 255.0f);
+        }
+        
+        textures[frame] = UpdateOverlayTexture(textures[frame], texels, OVERLAY_NOISE_SIZE,
+                                               OVERLAY_NOISE_SIZE, OVERLAY_TEXTURE_INTENSITY);
+    }
+    
+    free(texels);
+    return textures[OVERLAY_NOISE_FRAMES - 1] != 0;
+}
+
+int BuildPatternTextures(int* textures)
+{
+    for (int p = 0; p < OVERLAY_PATTERN_COUNT; p++) {
+        int w = gPatternSizes[p][0];
+        int h = gPatternSizes[p][1];
+        unsigned char texels[16 * 16];
+        
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                unsigned char coverage = 0;
+                if (p == OVERLAY_PATTERN_SCANLINES) {
+                    coverage = (y == 2) ? 255 : 0; // Dark line on every third row
+                } else {
+                    // Grid lines at half coverage so crossings add up like two blended lines
+                    coverage = (unsigned char)(((x == 0) + (y == 0)) * 255 / 2);
+                }
+                texels[y * w + x] = coverage;
+            }
+        }
+        
+        textures[p] = UpdateOverlayTexture(textures[p], texels, w, h, OVERLAY_TEXTURE_ALPHA);
+    }
+    
+    return textures[OVERLAY_PATTERN_COUNT - 1] != 0;
+}
+
+// A baked frame at a random offset, plus the occasional row of glitch lines
+void BuildNoiseGeometry(OverlayGeometry* geometry, const int* textures, unsigned int noiseSeed,
+                        int glitch, const OverlayLayout* layout)
+{
+    float w = layout->width;
+    float h = layout->height;
+    int frame = noiseSeed % OVERLAY_NOISE_FRAMES;
+    float u0 = (float)((noiseSeed >> 3) % OVERLAY_NOISE_SIZE) / OVERLAY_NOISE_SIZE;
+    float v0 = (float)((noiseSeed >> 12) % OVERLAY_NOISE_SIZE) / OVERLAY_NOISE_SIZE;
+    float u1 = u0 + w / OVERLAY_NOISE_SIZE;
+    float v1 = v0 + h / OVERLAY_NOISE_SIZE;
+    
+    const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    geometry->dynamic = 1;
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, textures[frame]);
+    AddOverlayTexturedQuad(geometry, 0, 0, w, h, u0, v0, u1, v1, white);
+    
+    if (glitch) {
+        BeginOverlayBatch(geometry, OVERLAY_PRIM_LINES, OVERLAY_BLEND_ALPHA, layout->tickLineWidth, 0);
+        for (int i = 0; i < 5; i++) {
+            float y = HashOverlayFrame(noiseSeed + i + 1) % layout->height;
+            AddOverlayVertex(geometry, 0, y, 1.0f, 1.0f, 1.0f, 0.3f);
+            AddOverlayVertex(geometry, w, y, 1.0f, 1.0f, 1.0f, 0.3f);
+        }
+    }
+}
+
+// Patterns are pixel-exact, so the quad only changes with the resolution
+void BuildPatternGeometry(OverlayGeometry* geometry, int pattern, int texture,
+                          const OverlayLayout* layout, const float* color)
+{
+    float u = (float)layout->width / gPatternSizes[pattern][0];
+    float v = (float)layout->height / gPatternSizes[pattern][1];
+    
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, texture);
+    AddOverlayTexturedQuad(geometry, 0, 0, layout->width, layout->height, 0, 0, u, v, color);
+}
+
+void BuildReticleGeometry(OverlayGeometry* geometry, const OverlayLayout* layout, int locked)
+{
+    float centerX = layout->centerX;
+    float centerY = layout->centerY;
+    float arm = layout->crosshairArm;
+    
+    float r = locked ? 1.0f : 0.0f;
+    float g = locked ? 0.0f : 1.0f;
+    float a = 0.9f;
+    
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_LINES, OVERLAY_BLEND_ALPHA, layout->reticleLineWidth, 0);
+    AddOverlayVertex(geometry, centerX - arm, centerY, r, g, 0.0f, a);
+    AddOverlayVertex(geometry, centerX + arm, centerY, r, g, 0.0f, a);
+    AddOverlayVertex(geometry, centerX, centerY - arm, r, g, 0.0f, a);
+    AddOverlayVertex(geometry, centerX, centerY + arm, r, g, 0.0f, a);
+    
+    float bracketSize = layout->bracketOffset;
+    float bracketLength = layout->bracketLength;
+    
+    // Four corner brackets, each a horizontal and a vertical stroke
+    for (int corner = 0; corner < 4; corner++) {
+        float sx = (corner & 1) ? 1.0f : -1.0f;
+        float sy = (corner & 2) ? 1.0f : -1.0f;
+        float x = centerX + sx * bracketSize;
+        float y = centerY + sy * bracketSize;
+        
+        AddOverlayVertex(geometry, x, y, r, g, 0.0f, a);
+        AddOverlayVertex(geometry, x - sx * bracketLength, y, r, g, 0.0f, a);
+        AddOverlayVertex(geometry, x, y, r, g, 0.0f, a);
+        AddOverlayVertex(geometry, x, y - sy * bracketLength, r, g, 0.0f, a);
+    }
+    
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_POINTS, OVERLAY_BLEND_ALPHA, layout->reticlePointSize, 0);
+    AddOverlayVertex(geometry, centerX, centerY, r, g, 0.0f, a);
+}
+
+// Range ticks down the left edge, appended to whatever filter geometry is being built
+void BuildRangeTickGeometry(OverlayGeometry* geometry, const OverlayLayout* layout)
+{
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_LINES, OVERLAY_BLEND_ALPHA, layout->tickLineWidth, 0);
+    for (int i = 0; i < OVERLAY_LAYOUT_TICKS; i++) {
+        AddOverlayVertex(geometry, layout->tickLeft, layout->tickY[i], 1.0f, 1.0f, 1.0f, 0.8f);
+        AddOverlayVertex(geometry, layout->tickRight, layout->tickY[i], 1.0f, 1.0f, 1.0f, 0.8f);
+    }
+}
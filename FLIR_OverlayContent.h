@@ -0,0 +1,67 @@
+/*
+ * Header file for the GL-free builders of the noise, pattern and reticle overlays
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_OVERLAYCONTENT_H
+#define FLIR_OVERLAYCONTENT_H
+
+#include "FLIR_OverlayGeometry.h"
+#include "FLIR_OverlayLayout.h"
+
+// Pre-generated camera noise frames, tiled across the screen
+#define OVERLAY_NOISE_FRAMES 8
+#define OVERLAY_NOISE_SIZE 512
+
+// Repeating overlay patterns, each drawn as one repeating quad. Texels are
+// pure coverage (alpha), colour and opacity come from the vertex colour.
+#define OVERLAY_PATTERN_SCANLINES 0
+#define OVERLAY_PATTERN_GRID_16 1
+#define OVERLAY_PATTERN_GRID_8 2
+#define OVERLAY_PATTERN_COUNT 3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Cheap integer hash so per-frame randomness needs no srand/rand state
+unsigned int HashOverlayFrame(unsigned int n);
+
+// Fill (or refill, when the handles are non-zero) the overlay textures
+int BuildNoiseTextures(int* textures, float intensity);
+int BuildPatternTextures(int* textures);
+
+// Builders take every coordinate from the layout, key the geometry on layout->key
+void BuildNoiseGeometry(OverlayGeometry* geometry, const int* textures, unsigned int noiseSeed,
+                        int glitch, const OverlayLayout* layout);
+void BuildPatternGeometry(OverlayGeometry* geometry, int pattern, int texture,
+                          const OverlayLayout* layout, const float* color);
+void BuildReticleGeometry(OverlayGeometry* geometry, const OverlayLayout* layout, int locked);
+void BuildRangeTickGeometry(OverlayGeometry* geometry, const OverlayLayout* layout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_OVERLAYCONTENT_H
@@ -0,0 +1,304 @@
+/*
+ * GL backend for the overlay compositor: vertex buffers, texture mirrors and the state-sorted draw
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#include "XPLMGraphics.h"
+#include "XPLMUtilities.h"
+#include "FLIR_GLExt.h"
+#include "FLIR_OverlayGL.h"
+#include "FLIR_GLStats.h"
+
+// Last state issued to GL, -1 means unknown
+typedef struct {
+    int texturing;
+    int texture;
+    int blend;
+    float lineWidth;
+    float pointSize;
+} OverlayState;
+
+// Per-frame counters: requested state vs what actually reached GL
+static int gStateRequests = 0;
+static int gStateChanges = 0;
+static int gLastRequests = 0;
+static int gLastChanges = 0;
+static int gCountersLogged = 0;
+
+static GLenum PrimitiveToGL(int primitive)
+{
+    switch (primitive) {
+        case OVERLAY_PRIM_LINES: return GL_LINES;
+        case OVERLAY_PRIM_POINTS: return GL_POINTS;
+        default: return GL_QUADS;
+    }
+}
+
+static void UploadOverlayGeometry(OverlayGeometry* geometry)
+{
+    InitializeGLExtensions();
+
+    if (HasBufferObjects()) {
+        if (!geometry->vbo) flirGenBuffers(1, &geometry->vbo);
+        flirBindBuffer(GL_ARRAY_BUFFER, geometry->vbo);
+        flirBufferData(GL_ARRAY_BUFFER, (FLIRGLsizeiptr)(geometry->vertexCount * sizeof(OverlayVertex)),
+                       geometry->vertices, geometry->dynamic ? GL_STREAM_DRAW : GL_STATIC_DRAW);
+    } else {
+        // No buffer objects: compile each batch into a display list instead
+        if (geometry->lists) glDeleteLists(geometry->lists, OVERLAY_MAX_BATCHES);
+        geometry->lists = glGenLists(OVERLAY_MAX_BATCHES);
+
+        for (int i = 0; i < geometry->batchCount; i++) {
+            const OverlayBatch* batch = &geometry->batches[i];
+            glNewList(geometry->lists + i, GL_COMPILE);
+            glBegin(PrimitiveToGL(batch->primitive));
+            for (int v = batch->first; v < batch->first + batch->count; v++) {
+                const OverlayVertex* vertex = &geometry->vertices[v];
+                glColor4f(vertex->r, vertex->g, vertex->b, vertex->a);
+                glTexCoord2f(vertex->u, vertex->v);
+                glVertex2f(vertex->x, vertex->y);
+            }
+            glEnd();
+            glEndList();
+        }
+    }
+
+    geometry->uploaded = 1;
+}
+
+static void BindOverlayGeometry(OverlayGeometry* geometry)
+{
+    if (!geometry->uploaded) UploadOverlayGeometry(geometry);
+    if (!geometry->vbo) return;
+
+    flirBindBuffer(GL_ARRAY_BUFFER, geometry->vbo);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(OverlayVertex), (const void*)offsetof(OverlayVertex, x));
+    glTexCoordPointer(2, GL_FLOAT, sizeof(OverlayVertex), (const void*)offsetof(OverlayVertex, u));
+    glColorPointer(4, GL_FLOAT, sizeof(OverlayVertex), (const void*)offsetof(OverlayVertex, r));
+}
+
+static void DrawOverlayBatch(const OverlayGeometry* geometry, int batchIndex)
+{
+    const OverlayBatch* batch = &geometry->batches[batchIndex];
+    if (geometry->vbo) {
+        glDrawArrays(PrimitiveToGL(batch->primitive), batch->first, batch->count);
+    } else if (geometry->lists) {
+        glCallList(geometry->lists + batchIndex);
+    }
+}
+
+static void UnbindOverlayGeometry()
+{
+    if (!HasBufferObjects()) return;
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    flirBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Binds the GL mirror of an overlay texture, re-uploading it when the texels changed
+static void BindOverlayTexture(int handle)
+{
+    OverlayTexture* texture = GetOverlayTexture(handle);
+    if (!texture) return;
+
+    if (!texture->glTexture) {
+        XPLMGenerateTextureNumbers(&texture->glTexture, 1);
+    }
+    XPLMBindTexture2d(texture->glTexture, 0);
+
+    if (texture->glVersion != texture->version) {
+        GLint internalFormat = texture->format == OVERLAY_TEXTURE_INTENSITY ? GL_INTENSITY8 : GL_ALPHA8;
+        GLenum format = texture->format == OVERLAY_TEXTURE_INTENSITY ? GL_LUMINANCE : GL_ALPHA;
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        // One byte per texel, so rows are only packed with alignment 1
+        GLint alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, texture->width, texture->height, 0,
+                     format, GL_UNSIGNED_BYTE, texture->texels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+        texture->glVersion = texture->version;
+    }
+}
+
+// Each Require* call is one state request; GL only sees the ones that differ
+static int RequireState(int changed)
+{
+    gStateRequests++;
+    if (changed) gStateChanges++;
+    return changed;
+}
+
+static void ApplyBlend(int blend)
+{
+    switch (blend) {
+        case OVERLAY_BLEND_MULTIPLY:
+            glBlendFunc(GL_DST_COLOR, GL_ZERO);
+            break;
+        case OVERLAY_BLEND_INVERT:
+            glBlendFunc(GL_ONE_MINUS_DST_COLOR, GL_ZERO);
+            break;
+        default:
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+    }
+}
+
+void EndOverlayPass()
+{
+    const OverlayItem* items;
+    int passWidth, passHeight;
+    int itemCount = FinishOverlayPass(&items, &passWidth, &passHeight);
+
+    gStateRequests = 0;
+    gStateChanges = 0;
+
+    if (itemCount == 0) {
+        gLastRequests = gLastChanges = 0;
+        return;
+    }
+
+    // One projection and one base state for the whole pass
+    XPLMSetGraphicsState(0, 0, 0, 0, 1, 0, 0);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, passWidth, passHeight, 0, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    OverlayState state = { 0, -1, -1, -1.0f, -1.0f };
+    OverlayGeometry* bound = NULL;
+
+    for (int i = 0; i < itemCount; i++) {
+        OverlayGeometry* geometry = items[i].geometry;
+        const OverlayBatch* batch = &geometry->batches[items[i].batch];
+        int texturing = batch->texture != 0;
+
+        if (RequireState(state.texturing != texturing)) {
+            XPLMSetGraphicsState(0, texturing, 0, 0, 1, 0, 0);
+            state.texturing = texturing;
+        }
+        if (texturing && RequireState(state.texture != batch->texture)) {
+            BindOverlayTexture(batch->texture);
+            state.texture = batch->texture;
+        }
+        if (RequireState(state.blend != batch->blend)) {
+            ApplyBlend(batch->blend);
+            state.blend = batch->blend;
+        }
+        if (batch->primitive == OVERLAY_PRIM_LINES && RequireState(state.lineWidth != batch->size)) {
+            glLineWidth(batch->size);
+            state.lineWidth = batch->size;
+        }
+        if (batch->primitive == OVERLAY_PRIM_POINTS && RequireState(state.pointSize != batch->size)) {
+            glPointSize(batch->size);
+            state.pointSize = batch->size;
+        }
+        if (RequireState(bound != geometry)) {
+            BindOverlayGeometry(geometry);
+            bound = geometry;
+        }
+
+        DrawOverlayBatch(geometry, items[i].batch);
+    }
+
+    // Restore once for the whole pass
+    UnbindOverlayGeometry();
+    if (state.lineWidth > 0.0f && state.lineWidth != 1.0f) glLineWidth(1.0f);
+    if (state.pointSize > 0.0f && state.pointSize != 1.0f) glPointSize(1.0f);
+    XPLMSetGraphicsState(0, 0, 0, 0, 1, 0, 0);
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+
+    gLastRequests = gStateRequests;
+    gLastChanges = gStateChanges;
+
+    if (!gCountersLogged) {
+        char message[128];
+        snprintf(message, sizeof(message), "FLIR: overlay pass issued %d of %d state changes\n",
+                 gLastChanges, gLastRequests);
+        XPLMDebugString(message);
+        gCountersLogged = 1;
+    }
+}
+
+void ReleaseOverlayGeometry(OverlayGeometry* geometry)
+{
+    if (geometry->vbo && flirDeleteBuffers) {
+        flirDeleteBuffers(1, &geometry->vbo);
+    }
+    if (geometry->lists) {
+        glDeleteLists(geometry->lists, OVERLAY_MAX_BATCHES);
+    }
+    geometry->vbo = 0;
+    geometry->lists = 0;
+    geometry->uploaded = 0;
+    geometry->built = 0;
+}
+
+void ReleaseOverlayResources()
+{
+    for (int handle = 1; handle <= GetOverlayTextureCount(); handle++) {
+        OverlayTexture* texture = GetOverlayTexture(handle);
+        if (texture->glTexture) {
+            GLuint name = (GLuint)texture->glTexture;
+            glDeleteTextures(1, &name);
+        }
+    }
+    ReleaseOverlayTextures();
+}
+
+void GetOverlayStateCounters(int* outRequests, int* outChanges, int* outRedundant)
+{
+    *outRequests = gLastRequests;
+    *outChanges = gLastChanges;
+    *outRedundant = gLastRequests - gLastChanges;
+}
+
+void GetOverlayStatus(char* statusBuffer, int bufferSize)
+{
+    snprintf(statusBuffer, bufferSize, "OVL: STATE %d/%d SKIPPED %d",
+             gLastChanges, gLastRequests, gLastRequests - gLastChanges);
+    statusBuffer[bufferSize - 1] = '\0';
+}
@@ -0,0 +1,50 @@
+/*
+ * Header file for the GL backend of the overlay compositor
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_OVERLAYGL_H
+#define FLIR_OVERLAYGL_H
+
+#include "FLIR_Overlay.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Draws the pass in one projection/state setup, issuing only the GL state that changes
+void EndOverlayPass();
+
+void ReleaseOverlayGeometry(OverlayGeometry* geometry);
+// Drops the GL mirrors of all overlay textures and their CPU texels
+void ReleaseOverlayResources();
+
+void GetOverlayStateCounters(int* outRequests, int* outChanges, int* outRedundant);
+void GetOverlayStatus(char* statusBuffer, int bufferSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_OVERLAYGL_H
@@ -0,0 +1,272 @@
+/*
+ * Overlay geometry recording: vertices, batches, textures and bitmap text kept on the CPU
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FLIR_OverlayGeometry.h"
+
+// 5x7 glyphs for ASCII 32..90, one byte per row with bit 4 the leftmost
+// column. Lowercase is drawn as uppercase, anything else as a blank.
+#define FONT_FIRST_CHAR 32
+#define FONT_GLYPHS 59
+#define FONT_CELL 8             // Atlas cell, glyph plus spacing
+#define FONT_COLUMNS 8
+#define FONT_ATLAS_SIZE 64
+
+static const unsigned char gFontGlyphs[FONT_GLYPHS][7] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // space
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // %
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // (
+    { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // )
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 }, // +
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // -
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, // .
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // /
+    { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, // 0
+    { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 1
+    { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, // 2
+    { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E }, // 3
+    { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, // 4
+    { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E }, // 5
+    { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, // 6
+    { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // 7
+    { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, // 8
+    { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C }, // 9
+    { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // :
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 }, // A
+    { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, // B
+    { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E }, // C
+    { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, // D
+    { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F }, // E
+    { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, // F
+    { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F }, // G
+    { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // H
+    { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // I
+    { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, // J
+    { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // K
+    { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, // L
+    { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 }, // M
+    { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // N
+    { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // O
+    { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, // P
+    { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D }, // Q
+    { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, // R
+    { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E }, // S
+    { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // T
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // U
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // V
+    { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A }, // W
+    { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, // X
+    { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 }, // Y
+    { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }, // Z
+};
+
+static OverlayTexture gTextures[OVERLAY_MAX_TEXTURES];
+static int gTextureCount = 0;
+static int gFontTexture = 0;
+
+void ResetOverlayGeometry(OverlayGeometry* geometry, unsigned int key)
+{
+    geometry->vertexCount = 0;
+    geometry->batchCount = 0;
+    geometry->overflow = 0;
+    geometry->key = key;
+    geometry->built = 1;
+    geometry->uploaded = 0;
+}
+
+int BeginOverlayBatch(OverlayGeometry* geometry, int primitive, int blend, float size, int texture)
+{
+    if (geometry->batchCount >= OVERLAY_MAX_BATCHES) {
+        geometry->overflow = 1;
+        return 0;
+    }
+
+    OverlayBatch* batch = &geometry->batches[geometry->batchCount++];
+    batch->primitive = primitive;
+    batch->blend = blend;
+    batch->size = size;
+    batch->texture = texture;
+    batch->first = geometry->vertexCount;
+    batch->count = 0;
+    return 1;
+}
+
+static void AddVertex(OverlayGeometry* geometry, float x, float y, float u, float v, const float* color)
+{
+    if (geometry->batchCount == 0 || geometry->overflow || geometry->vertexCount >= OVERLAY_MAX_VERTICES) return;
+
+    OverlayVertex* vertex = &geometry->vertices[geometry->vertexCount++];
+    vertex->x = x;
+    vertex->y = y;
+    vertex->u = u;
+    vertex->v = v;
+    vertex->r = color[0];
+    vertex->g = color[1];
+    vertex->b = color[2];
+    vertex->a = color[3];
+    geometry->batches[geometry->batchCount - 1].count++;
+}
+
+void AddOverlayVertex(OverlayGeometry* geometry, float x, float y, float r, float g, float b, float a)
+{
+    const float color[4] = { r, g, b, a };
+    AddVertex(geometry, x, y, 0.0f, 0.0f, color);
+}
+
+void AddOverlayQuad(OverlayGeometry* geometry, float x0, float y0, float x1, float y1,
+                    const float* topColor, const float* bottomColor)
+{
+    // Quads are whole or nothing, a clipped one would corrupt the batch
+    if (geometry->vertexCount + 4 > OVERLAY_MAX_VERTICES) return;
+
+    AddVertex(geometry, x0, y0, 0.0f, 0.0f, topColor);
+    AddVertex(geometry, x1, y0, 0.0f, 0.0f, topColor);
+    AddVertex(geometry, x1, y1, 0.0f, 0.0f, bottomColor);
+    AddVertex(geometry, x0, y1, 0.0f, 0.0f, bottomColor);
+}
+
+void AddOverlayTexturedQuad(OverlayGeometry* geometry, float x0, float y0, float x1, float y1,
+                            float u0, float v0, float u1, float v1, const float* color)
+{
+    // Quads are whole or nothing, a clipped one would corrupt the batch
+    if (geometry->vertexCount + 4 > OVERLAY_MAX_VERTICES) return;
+
+    AddVertex(geometry, x0, y0, u0, v0, color);
+    AddVertex(geometry, x1, y0, u1, v0, color);
+    AddVertex(geometry, x1, y1, u1, v1, color);
+    AddVertex(geometry, x0, y1, u0, v1, color);
+}
+
+static void BuildFontTexture()
+{
+    unsigned char texels[FONT_ATLAS_SIZE * FONT_ATLAS_SIZE];
+    memset(texels, 0, sizeof(texels));
+
+    for (int glyph = 0; glyph < FONT_GLYPHS; glyph++) {
+        int cellX = (glyph % FONT_COLUMNS) * FONT_CELL;
+        int cellY = (glyph / FONT_COLUMNS) * FONT_CELL;
+        for (int row = 0; row < 7; row++) {
+            for (int column = 0; column < 5; column++) {
+                if (gFontGlyphs[glyph][row] & (0x10 >> column)) {
+                    texels[(cellY + row) * FONT_ATLAS_SIZE + cellX + column] = 255;
+                }
+            }
+        }
+    }
+
+    gFontTexture = UpdateOverlayTexture(0, texels, FONT_ATLAS_SIZE, FONT_ATLAS_SIZE, OVERLAY_TEXTURE_ALPHA);
+}
+
+void AddOverlayText(OverlayGeometry* geometry, float x, float y, float scale,
+                    const char* text, const float* color)
+{
+    if (!gFontTexture) {
+        BuildFontTexture();
+        if (!gFontTexture) return;
+    }
+
+    if (!BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, gFontTexture)) return;
+
+    float advance = OVERLAY_GLYPH_WIDTH * scale;
+    float height = OVERLAY_GLYPH_HEIGHT * scale;
+    for (const char* c = text; *c; c++) {
+        int code = (*c >= 'a' && *c <= 'z') ? *c - 'a' + 'A' : *c;
+        int glyph = code - FONT_FIRST_CHAR;
+        // Spaces and unknown characters only advance the pen
+        if (glyph > 0 && glyph < FONT_GLYPHS) {
+            float u = (float)((glyph % FONT_COLUMNS) * FONT_CELL) / FONT_ATLAS_SIZE;
+            float v = (float)((glyph / FONT_COLUMNS) * FONT_CELL) / FONT_ATLAS_SIZE;
+            AddOverlayTexturedQuad(geometry, x, y, x + advance, y + height,
+                                   u, v, u + (float)OVERLAY_GLYPH_WIDTH / FONT_ATLAS_SIZE,
+                                   v + (float)OVERLAY_GLYPH_HEIGHT / FONT_ATLAS_SIZE, color);
+        }
+        x += advance;
+    }
+}
+
+int UpdateOverlayTexture(int handle, const unsigned char* texels, int width, int height, int format)
+{
+    if (handle == 0) {
+        if (gTextureCount >= OVERLAY_MAX_TEXTURES) return 0;
+        handle = ++gTextureCount;
+        memset(&gTextures[handle - 1], 0, sizeof(OverlayTexture));
+    }
+
+    OverlayTexture* texture = GetOverlayTexture(handle);
+    if (!texture) return 0;
+
+    if (!texture->texels || texture->width != width || texture->height != height) {
+        free(texture->texels);
+        texture->texels = (unsigned char*)malloc(width * height);
+        if (!texture->texels) return 0;
+    }
+
+    memcpy(texture->texels, texels, width * height);
+    texture->width = width;
+    texture->height = height;
+    texture->format = format;
+    texture->version++;
+    return handle;
+}
+
+OverlayTexture* GetOverlayTexture(int handle)
+{
+    if (handle < 1 || handle > gTextureCount) return NULL;
+    return &gTextures[handle - 1];
+}
+
+int GetOverlayTextureCount()
+{
+    return gTextureCount;
+}
+
+// CPU side only, the GL backend must have dropped its copies first
+void ReleaseOverlayTextures()
+{
+    for (int i = 0; i < gTextureCount; i++) {
+        free(gTextures[i].texels);
+        memset(&gTextures[i], 0, sizeof(OverlayTexture));
+    }
+    gTextureCount = 0;
+    gFontTexture = 0;
+}
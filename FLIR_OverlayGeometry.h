@@ -0,0 +1,127 @@
+/*
+ * Header file for overlay geometry recorded into a CPU command buffer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_OVERLAYGEOMETRY_H
+#define FLIR_OVERLAYGEOMETRY_H
+
+// Recording only: nothing here touches GL or XPLM, so the geometry can be
+// built and rasterized on a headless box (see FLIR_OverlayRaster.h)
+
+#define OVERLAY_MAX_VERTICES 256
+#define OVERLAY_MAX_BATCHES 8
+#define OVERLAY_MAX_TEXTURES 16
+
+// Primitive types
+#define OVERLAY_PRIM_LINES 0
+#define OVERLAY_PRIM_QUADS 1
+#define OVERLAY_PRIM_POINTS 2
+
+// Blend functions used by the overlays
+#define OVERLAY_BLEND_ALPHA 0       // SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+#define OVERLAY_BLEND_MULTIPLY 1    // DST_COLOR, ZERO
+#define OVERLAY_BLEND_INVERT 2      // ONE_MINUS_DST_COLOR, ZERO
+
+// Single channel texel formats, both modulate the vertex colour
+#define OVERLAY_TEXTURE_ALPHA 0     // Coverage: alpha = colour alpha * texel
+#define OVERLAY_TEXTURE_INTENSITY 1 // All four channels scaled by the texel
+
+// Glyph cell of the built-in bitmap font, in pixels at scale 1
+#define OVERLAY_GLYPH_WIDTH 6
+#define OVERLAY_GLYPH_HEIGHT 8
+
+typedef struct {
+    float x, y;
+    float u, v;
+    float r, g, b, a;
+} OverlayVertex;
+
+// A run of vertices drawn with one primitive type and one blend/width/texture state
+typedef struct {
+    int primitive;
+    int blend;
+    float size;             // Line width or point size
+    int texture;            // Overlay texture handle, 0 for untextured
+    int first;
+    int count;
+} OverlayBatch;
+
+// CPU copy of the geometry plus the GL backend's cache. Callers rebuild it
+// only when their key (screen size, lock state, mode...) changes.
+typedef struct {
+    OverlayVertex vertices[OVERLAY_MAX_VERTICES];
+    OverlayBatch batches[OVERLAY_MAX_BATCHES];
+    int vertexCount;
+    int batchCount;
+    unsigned int key;
+    int built;
+    int dynamic;            // Rebuilt often, uploaded with a streaming hint
+    int overflow;           // A batch was refused, vertices are dropped until the next reset
+    unsigned int vbo;       // GL backend cache
+    unsigned int lists;
+    int uploaded;
+} OverlayGeometry;
+
+// Repeating single channel texture kept on the CPU; the GL backend mirrors
+// it into a texture object whenever the version changes
+typedef struct {
+    unsigned char* texels;
+    int width;
+    int height;
+    int format;
+    int version;
+    int glTexture;          // GL backend cache
+    int glVersion;
+} OverlayTexture;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void ResetOverlayGeometry(OverlayGeometry* geometry, unsigned int key);
+// Returns 0 when all batches are taken; the geometry then refuses vertices
+// rather than appending them to the previous batch with the wrong state
+int BeginOverlayBatch(OverlayGeometry* geometry, int primitive, int blend, float size, int texture);
+void AddOverlayVertex(OverlayGeometry* geometry, float x, float y, float r, float g, float b, float a);
+void AddOverlayQuad(OverlayGeometry* geometry, float x0, float y0, float x1, float y1,
+                    const float* topColor, const float* bottomColor);
+void AddOverlayTexturedQuad(OverlayGeometry* geometry, float x0, float y0, float x1, float y1,
+                            float u0, float v0, float u1, float v1, const float* color);
+
+// Starts its own alpha-blended batch; glyphs are OVERLAY_GLYPH_WIDTH * scale apart
+void AddOverlayText(OverlayGeometry* geometry, float x, float y, float scale,
+                    const char* text, const float* color);
+
+// Creates a texture when handle is 0, otherwise replaces its texels. Returns the handle.
+int UpdateOverlayTexture(int handle, const unsigned char* texels, int width, int height, int format);
+OverlayTexture* GetOverlayTexture(int handle);
+int GetOverlayTextureCount();
+void ReleaseOverlayTextures();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_OVERLAYGEOMETRY_H
@@ -0,0 +1,83 @@
+/*
+ * Overlay layout computed once per screen size and UI scale
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "FLIR_OverlayLayout.h"
+
+static OverlayLayout gLayout;
+static unsigned int gLayoutGeneration = 0;
+
+void ComputeOverlayLayout(OverlayLayout* layout, int screenWidth, int screenHeight, float uiScale)
+{
+    float w = (float)screenWidth;
+    float h = (float)screenHeight;
+    float s = uiScale;
+
+    layout->width = screenWidth;
+    layout->height = screenHeight;
+    layout->uiScale = uiScale;
+
+    layout->centerX = w / 2.0f;
+    layout->centerY = h / 2.0f;
+
+    layout->crosshairArm = 20.0f * s;
+    layout->bracketOffset = 50.0f * s;
+    layout->bracketLength = 20.0f * s;
+    layout->reticleLineWidth = 2.0f * s;
+    layout->reticlePointSize = 3.0f * s;
+
+    float margin = 50.0f * s;
+    layout->tickLeft = 10.0f * s;
+    layout->tickRight = 25.0f * s;
+    for (int i = 0; i < OVERLAY_LAYOUT_TICKS; i++) {
+        layout->tickY[i] = margin + i * (h - 2.0f * margin) / OVERLAY_LAYOUT_TICKS;
+    }
+    layout->tickLineWidth = s;
+
+    layout->horizonY = h * 0.5f;
+
+    layout->textScale = s >= 1.0f ? (float)(int)(s + 0.5f) : 1.0f;
+}
+
+const OverlayLayout* UpdateOverlayLayout(int screenWidth, int screenHeight, float uiScale)
+{
+    // The sim reports 0 before its preferences are loaded
+    if (uiScale <= 0.0f) uiScale = 1.0f;
+
+    if (gLayoutGeneration == 0 || gLayout.width != screenWidth || gLayout.height != screenHeight ||
+        gLayout.uiScale != uiScale) {
+        ComputeOverlayLayout(&gLayout, screenWidth, screenHeight, uiScale);
+
+        // Zero is reserved for "no layout computed yet"
+        if (++gLayoutGeneration == 0) gLayoutGeneration = 1;
+        gLayout.key = gLayoutGeneration;
+    }
+    return &gLayout;
+}
+
+const OverlayLayout* GetOverlayLayout()
+{
+    return &gLayout;
+}
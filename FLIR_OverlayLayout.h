@@ -0,0 +1,79 @@
+/*
+ * Header file for the overlay layout shared by all overlay builders
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_OVERLAYLAYOUT_H
+#define FLIR_OVERLAYLAYOUT_H
+
+#define OVERLAY_LAYOUT_TICKS 10
+
+// Every screen coordinate the overlays use, computed once per screen size or
+// UI scale. Geometry built from a layout is keyed on its key, so it is only
+// rebuilt when the layout actually changes.
+typedef struct {
+    int width;
+    int height;
+    float uiScale;
+    unsigned int key;               // New value whenever anything below changes
+
+    float centerX;
+    float centerY;
+
+    // Reticle: crosshair arms, corner brackets and the centre dot
+    float crosshairArm;
+    float bracketOffset;
+    float bracketLength;
+    float reticleLineWidth;
+    float reticlePointSize;
+
+    // Range ticks down the left edge
+    float tickLeft;
+    float tickRight;
+    float tickY[OVERLAY_LAYOUT_TICKS];
+    float tickLineWidth;
+
+    // Sky and ground gradients meet here
+    float horizonY;
+
+    // Text cell scale for labels drawn with AddOverlayText
+    float textScale;
+} OverlayLayout;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fills a standalone layout, e.g. for rendering overlays off-screen
+void ComputeOverlayLayout(OverlayLayout* layout, int screenWidth, int screenHeight, float uiScale);
+
+// Recomputes only when the size or scale differs from the current layout
+const OverlayLayout* UpdateOverlayLayout(int screenWidth, int screenHeight, float uiScale);
+const OverlayLayout* GetOverlayLayout();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_OVERLAYLAYOUT_H
@@ -0,0 +1,260 @@
+/*
+ * Software rasterizer backend for the overlay compositor, drawing into a CPU RGBA buffer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "FLIR_OverlayRaster.h"
+
+typedef struct {
+    float x, y;
+    float u, v;
+    float color[4];
+} RasterVertex;
+
+static int gRasterBatches = 0;
+static long long gRasterFragments = 0;
+
+static void ToRasterVertex(const OverlayVertex* vertex, RasterVertex* out)
+{
+    out->x = vertex->x;
+    out->y = vertex->y;
+    out->u = vertex->u;
+    out->v = vertex->v;
+    out->color[0] = vertex->r;
+    out->color[1] = vertex->g;
+    out->color[2] = vertex->b;
+    out->color[3] = vertex->a;
+}
+
+// GL_MODULATE with nearest filtering and GL_REPEAT wrapping
+static void ApplyTexture(const OverlayTexture* texture, float u, float v, float* color)
+{
+    int tx = (int)floorf(u * texture->width) % texture->width;
+    int ty = (int)floorf(v * texture->height) % texture->height;
+    if (tx < 0) tx += texture->width;
+    if (ty < 0) ty += texture->height;
+
+    float texel = texture->texels[ty * texture->width + tx] / 255.0f;
+    if (texture->format == OVERLAY_TEXTURE_INTENSITY) {
+        color[0] *= texel;
+        color[1] *= texel;
+        color[2] *= texel;
+    }
+    color[3] *= texel;
+}
+
+static void BlendFragment(unsigned char* pixel, const float* color, int blend)
+{
+    for (int c = 0; c < 4; c++) {
+        float source = color[c] < 0.0f ? 0.0f : (color[c] > 1.0f ? 1.0f : color[c]);
+        float destination = pixel[c] / 255.0f;
+        float result;
+        switch (blend) {
+            case OVERLAY_BLEND_MULTIPLY:
+                result = source * destination;
+                break;
+            case OVERLAY_BLEND_INVERT:
+                result = source * (1.0f - destination);
+                break;
+            default: {
+                float alpha = color[3] < 0.0f ? 0.0f : (color[3] > 1.0f ? 1.0f : color[3]);
+                result = source * alpha + destination * (1.0f - alpha);
+                break;
+            }
+        }
+        pixel[c] = (unsigned char)(result * 255.0f + 0.5f);
+    }
+}
+
+static float EdgeFunction(const RasterVertex* a, const RasterVertex* b, float px, float py)
+{
+    return (b->x - a->x) * (py - a->y) - (b->y - a->y) * (px - a->x);
+}
+
+// Tie-break for pixel centres exactly on an edge. A shared edge is walked in
+// opposite directions by its two triangles, so exactly one of them owns it.
+static int OwnsEdge(const RasterVertex* a, const RasterVertex* b)
+{
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+    return dy > 0.0f || (dy == 0.0f && dx > 0.0f);
+}
+
+static void RasterizeTriangle(OverlayRasterTarget* target, const RasterVertex* v0, const RasterVertex* v1,
+                              const RasterVertex* v2, const OverlayBatch* batch, const OverlayTexture* texture)
+{
+    float area = EdgeFunction(v0, v1, v2->x, v2->y);
+    if (area == 0.0f) return;
+    if (area < 0.0f) {
+        const RasterVertex* swap = v1;
+        v1 = v2;
+        v2 = swap;
+        area = -area;
+    }
+
+    int minX = (int)floorf(fminf(v0->x, fminf(v1->x, v2->x)));
+    int maxX = (int)ceilf(fmaxf(v0->x, fmaxf(v1->x, v2->x)));
+    int minY = (int)floorf(fminf(v0->y, fminf(v1->y, v2->y)));
+    int maxY = (int)ceilf(fmaxf(v0->y, fmaxf(v1->y, v2->y)));
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX > target->width) maxX = target->width;
+    if (maxY > target->height) maxY = target->height;
+
+    int owns0 = OwnsEdge(v1, v2);
+    int owns1 = OwnsEdge(v2, v0);
+    int owns2 = OwnsEdge(v0, v1);
+
+    for (int y = minY; y < maxY; y++) {
+        float py = y + 0.5f;
+        for (int x = minX; x < maxX; x++) {
+            float px = x + 0.5f;
+            float w0 = EdgeFunction(v1, v2, px, py);
+            float w1 = EdgeFunction(v2, v0, px, py);
+            float w2 = EdgeFunction(v0, v1, px, py);
+
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+            if ((w0 == 0.0f && !owns0) || (w1 == 0.0f && !owns1) || (w2 == 0.0f && !owns2)) continue;
+
+            w0 /= area;
+            w1 /= area;
+            w2 /= area;
+
+            float color[4];
+            for (int c = 0; c < 4; c++) {
+                color[c] = v0->color[c] * w0 + v1->color[c] * w1 + v2->color[c] * w2;
+            }
+            if (texture) {
+                ApplyTexture(texture, v0->u * w0 + v1->u * w1 + v2->u * w2,
+                             v0->v * w0 + v1->v * w1 + v2->v * w2, color);
+            }
+
+            BlendFragment(&target->pixels[(y * target->width + x) * 4], color, batch->blend);
+            gRasterFragments++;
+        }
+    }
+}
+
+static void RasterizeQuad(OverlayRasterTarget* target, const RasterVertex* quad,
+                          const OverlayBatch* batch, const OverlayTexture* texture)
+{
+    RasterizeTriangle(target, &quad[0], &quad[1], &quad[2], batch, texture);
+    RasterizeTriangle(target, &quad[0], &quad[2], &quad[3], batch, texture);
+}
+
+// Wide lines as a rectangle of the line width around the segment
+static void RasterizeLine(OverlayRasterTarget* target, const RasterVertex* a, const RasterVertex* b,
+                          const OverlayBatch* batch, const OverlayTexture* texture)
+{
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+    float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+
+    float halfWidth = (batch->size > 0.0f ? batch->size : 1.0f) * 0.5f;
+    float nx = -dy / length * halfWidth;
+    float ny = dx / length * halfWidth;
+
+    RasterVertex quad[4] = { *a, *b, *b, *a };
+    quad[0].x += nx; quad[0].y += ny;
+    quad[1].x += nx; quad[1].y += ny;
+    quad[2].x -= nx; quad[2].y -= ny;
+    quad[3].x -= nx; quad[3].y -= ny;
+    RasterizeQuad(target, quad, batch, texture);
+}
+
+static void RasterizePoint(OverlayRasterTarget* target, const RasterVertex* point,
+                           const OverlayBatch* batch, const OverlayTexture* texture)
+{
+    float half = (batch->size > 0.0f ? batch->size : 1.0f) * 0.5f;
+
+    RasterVertex quad[4] = { *point, *point, *point, *point };
+    quad[0].x -= half; quad[0].y -= half;
+    quad[1].x += half; quad[1].y -= half;
+    quad[2].x += half; quad[2].y += half;
+    quad[3].x -= half; quad[3].y += half;
+    RasterizeQuad(target, quad, batch, texture);
+}
+
+static void RasterizeBatch(OverlayRasterTarget* target, const OverlayGeometry* geometry, const OverlayBatch* batch)
+{
+    const OverlayTexture* texture = batch->texture ? GetOverlayTexture(batch->texture) : NULL;
+    if (texture && !texture->texels) texture = NULL;
+
+    int stride = batch->primitive == OVERLAY_PRIM_QUADS ? 4 : (batch->primitive == OVERLAY_PRIM_LINES ? 2 : 1);
+    int last = batch->first + batch->count - stride;
+
+    for (int i = batch->first; i <= last; i += stride) {
+        RasterVertex vertices[4];
+        for (int v = 0; v < stride; v++) {
+            ToRasterVertex(&geometry->vertices[i + v], &vertices[v]);
+        }
+
+        switch (batch->primitive) {
+            case OVERLAY_PRIM_QUADS:
+                RasterizeQuad(target, vertices, batch, texture);
+                break;
+            case OVERLAY_PRIM_LINES:
+                RasterizeLine(target, &vertices[0], &vertices[1], batch, texture);
+                break;
+            default:
+                RasterizePoint(target, &vertices[0], batch, texture);
+                break;
+        }
+    }
+}
+
+void RasterizeOverlayPass(OverlayRasterTarget* target)
+{
+    const OverlayItem* items;
+    int passWidth, passHeight;
+    int itemCount = FinishOverlayPass(&items, &passWidth, &passHeight);
+
+    gRasterBatches = 0;
+    gRasterFragments = 0;
+
+    for (int i = 0; i < itemCount; i++) {
+        const OverlayGeometry* geometry = items[i].geometry;
+        RasterizeBatch(target, geometry, &geometry->batches[items[i].batch]);
+        gRasterBatches++;
+    }
+}
+
+void RasterizeOverlayGeometry(OverlayRasterTarget* target, const OverlayGeometry* geometry)
+{
+    for (int i = 0; i < geometry->batchCount; i++) {
+        RasterizeBatch(target, geometry, &geometry->batches[i]);
+    }
+}
+
+void GetOverlayRasterStats(int* outBatches, long long* outFragments)
+{
+    *outBatches = gRasterBatches;
+    *outFragments = gRasterFragments;
+}
@@ -0,0 +1,57 @@
+/*
+ * Header file for the software rasterizer backend of the overlay compositor
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_OVERLAYRASTER_H
+#define FLIR_OVERLAYRASTER_H
+
+#include "FLIR_Overlay.h"
+
+// RGBA8 target, row 0 at the top like the overlay's ortho projection
+typedef struct {
+    unsigned char* pixels;
+    int width;
+    int height;
+} OverlayRasterTarget;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Blends the pass into the target with the same blend, texture and colour
+// rules as the GL backend. Needs no GL context, so it runs headless.
+void RasterizeOverlayPass(OverlayRasterTarget* target);
+
+// Blends every batch of one geometry in recorded order, outside of any pass
+void RasterizeOverlayGeometry(OverlayRasterTarget* target, const OverlayGeometry* geometry);
+
+// Batches and fragments shaded by the last RasterizeOverlayPass
+void GetOverlayRasterStats(int* outBatches, long long* outFragments);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_OVERLAYRASTER_H
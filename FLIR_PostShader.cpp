@@ -0,0 +1,319 @@
+/*
+ * GLSL post-processing path: the frame stays on the GPU and is reshaded by the same rules as the CPU kernel
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "XPLMGraphics.h"
+#include "XPLMUtilities.h"
+#include "FLIR_GLExt.h"
+#include "FLIR_VisualEffects.h"
+#include "FLIR_TerrainClassifier.h"
+#include "FLIR_PostShader.h"
+#include "FLIR_GLStats.h"
+
+// Texture units
+#define UNIT_SCENE 0
+#define UNIT_TRANSFER 1
+#define UNIT_RANGE 2
+#define UNIT_ATTENUATION 3
+#define UNIT_TERRAIN 4
+#define UNIT_COUNT 5
+
+// Mirror of ProcessEOIROptimized, integer steps done with floor() so both
+// paths produce the same gray levels. Keep the two in sync.
+static const char* gFragmentSource =
+    "uniform sampler2D scene;\n"
+    "uniform sampler2D transfer;\n"
+    "uniform sampler2D range;\n"
+    "uniform sampler2D attenuation;\n"
+    "uniform sampler2D terrain;\n"
+    "uniform float heat[MATERIAL_COUNT];\n"
+    "uniform float mode;\n"
+    "uniform float pathLevel;\n"
+    "uniform vec2 screenSize;\n"
+    "uniform vec3 rangeGrid;\n"           // width, height, cell; width 0 = no range
+    "uniform vec3 horizon;\n"
+    "uniform float horizonValid;\n"
+    "uniform float terrainValid;\n"
+    "\n"
+    "float Byte(float value) { return floor(value * 255.0 + 0.5); }\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 pixel = gl_FragCoord.xy - 0.5;\n"
+    "    vec3 rgb = floor(texture2D(scene, gl_FragCoord.xy / screenSize).rgb * 255.0 + 0.5);\n"
+    "    float gray = floor((rgb.r * 77.0 + rgb.g * 151.0 + rgb.b * 28.0) / 256.0);\n"
+    "\n"
+    "    float sky = -1.0;\n"
+    "    float bucket = RANGE_SKY_BUCKET;\n"
+    "    if (rangeGrid.x > 0.0) {\n"
+    "        vec2 cell = floor(pixel / rangeGrid.z);\n"
+    "        bucket = Byte(texture2D(range, (cell + 0.5) / rangeGrid.xy).r);\n"
+    "        sky = bucket == RANGE_SKY_BUCKET ? 1.0 : 0.0;\n"
+    "    } else if (horizonValid > 0.5) {\n"
+    "        sky = horizon.x + horizon.y * gl_FragCoord.x + horizon.z * gl_FragCoord.y > 0.0 ? 1.0 : 0.0;\n"
+    "    }\n"
+    "\n"
+    "    float heatBonus;\n"
+    "    if (sky == 1.0) {\n"
+    "        heatBonus = heat[MATERIAL_SKY];\n"
+    "    } else {\n"
+    "        int material = MATERIAL_NEUTRAL;\n"
+    "        vec2 terrainCell = floor(pixel * vec2(TERRAIN_WIDTH, TERRAIN_HEIGHT) / screenSize);\n"
+    "        if (terrainValid > 0.5 &&\n"
+    "            Byte(texture2D(terrain, (terrainCell + 0.5) / vec2(TERRAIN_WIDTH, TERRAIN_HEIGHT)).r) == TERRAIN_WATER) {\n"
+    "            material = MATERIAL_WATER;\n"
+    "        } else if (sky < 0.0 && rgb.b > rgb.r && rgb.b > rgb.g && rgb.b > 100.0) {\n"
+    "            material = MATERIAL_SKY;\n"
+    "        } else if (rgb.g > rgb.r && rgb.g > rgb.b && rgb.g > 80.0) {\n"
+    "            material = MATERIAL_VEGETATION;\n"
+    "        } else if (abs(rgb.r - rgb.g) < 20.0 && abs(rgb.g - rgb.b) < 20.0 && gray > 60.0) {\n"
+    "            material = MATERIAL_CONCRETE;\n"
+    "        } else if (gray > 200.0) {\n"
+    "            material = MATERIAL_HOT;\n"
+    "        } else if (gray < 40.0) {\n"
+    "            material = MATERIAL_SHADOW;\n"
+    "        }\n"
+    "        heatBonus = heat[material] + (sky < 0.0 ? floor(pixel.y / screenSize.y * 15.0) : 15.0);\n"
+    "    }\n"
+    "\n"
+    "    // Monochrome halves the heat, truncating like integer division\n"
+    "    if (mode == 0.0) heatBonus = heatBonus < 0.0 ? ceil(heatBonus * 0.5) : floor(heatBonus * 0.5);\n"
+    "    gray += heatBonus;\n"
+    "\n"
+    "    if (bucket != RANGE_SKY_BUCKET) {\n"
+    "        vec2 fixedPoint = texture2D(attenuation, vec2((bucket + 0.5) / RANGE_BUCKETS, 0.5)).ra;\n"
+    "        float transmission = Byte(fixedPoint.x) * 256.0 + Byte(fixedPoint.y);\n"
+    "        gray = pathLevel + floor((gray - pathLevel) * transmission / 256.0);\n"
+    "    }\n"
+    "\n"
+    "    float index = clamp(gray + TRANSFER_OFFSET, 0.0, TRANSFER_SIZE - 1.0);\n"
+    "    gl_FragColor = vec4(texture2D(transfer, vec2((index + 0.5) / TRANSFER_SIZE, (mode + 0.5) / 3.0)).rgb, 1.0);\n"
+    "}\n";
+
+static int gShaderFailed = 0;
+static GLuint gProgram = 0;
+static int gTextures[UNIT_COUNT];
+static int gTexturesReady = 0;
+static int gSceneWidth = 0;
+static int gSceneHeight = 0;
+static int gRangeTextureWidth = 0;
+static int gRangeTextureHeight = 0;
+static int gUploadedTransfer = -1;
+static int gUploadedAttenuation = -1;
+static int gUploadedRange = -1;
+
+static struct {
+    GLint heat;
+    GLint mode;
+    GLint pathLevel;
+    GLint screenSize;
+    GLint rangeGrid;
+    GLint horizon;
+    GLint horizonValid;
+    GLint terrainValid;
+} gUniforms;
+
+static int BuildProgram()
+{
+    // Constants shared with the C side go in as defines ahead of the body
+    char prelude[1024];
+    snprintf(prelude, sizeof(prelude),
+             "#version 120\n"
+             "#define MATERIAL_COUNT %d\n#define MATERIAL_NEUTRAL %d\n#define MATERIAL_SKY %d\n"
+             "#define MATERIAL_VEGETATION %d\n#define MATERIAL_CONCRETE %d\n#define MATERIAL_HOT %d\n"
+             "#define MATERIAL_SHADOW %d\n#define MATERIAL_WATER %d\n"
+             "#define RANGE_BUCKETS %d.0\n#define RANGE_SKY_BUCKET %d.0\n"
+             "#define TERRAIN_WIDTH %d.0\n#define TERRAIN_HEIGHT %d.0\n#define TERRAIN_WATER %d.0\n"
+             "#define TRANSFER_SIZE %d.0\n#define TRANSFER_OFFSET %d.0\n",
+             FLIR_MATERIAL_COUNT, FLIR_MATERIAL_NEUTRAL, FLIR_MATERIAL_SKY,
+             FLIR_MATERIAL_VEGETATION, FLIR_MATERIAL_CONCRETE, FLIR_MATERIAL_HOT,
+             FLIR_MATERIAL_SHADOW, FLIR_MATERIAL_WATER,
+             FLIR_RANGE_BUCKETS, FLIR_RANGE_SKY_BUCKET,
+             FLIR_TERRAIN_MASK_WIDTH, FLIR_TERRAIN_MASK_HEIGHT, FLIR_TERRAIN_WATER,
+             FLIR_TRANSFER_SIZE, FLIR_TRANSFER_OFFSET);
+
+    gProgram = BuildFragmentProgram(prelude, gFragmentSource, "post");
+    if (!gProgram) return 0;
+
+    flirUseProgram(gProgram);
+    flirUniform1i(flirGetUniformLocation(gProgram, "scene"), UNIT_SCENE);
+    flirUniform1i(flirGetUniformLocation(gProgram, "transfer"), UNIT_TRANSFER);
+    flirUniform1i(flirGetUniformLocation(gProgram, "range"), UNIT_RANGE);
+    flirUniform1i(flirGetUniformLocation(gProgram, "attenuation"), UNIT_ATTENUATION);
+    flirUniform1i(flirGetUniformLocation(gProgram, "terrain"), UNIT_TERRAIN);
+    gUniforms.heat = flirGetUniformLocation(gProgram, "heat");
+    gUniforms.mode = flirGetUniformLocation(gProgram, "mode");
+    gUniforms.pathLevel = flirGetUniformLocation(gProgram, "pathLevel");
+    gUniforms.screenSize = flirGetUniformLocation(gProgram, "screenSize");
+    gUniforms.rangeGrid = flirGetUniformLocation(gProgram, "rangeGrid");
+    gUniforms.horizon = flirGetUniformLocation(gProgram, "horizon");
+    gUniforms.horizonValid = flirGetUniformLocation(gProgram, "horizonValid");
+    gUniforms.terrainValid = flirGetUniformLocation(gProgram, "terrainValid");
+    flirUseProgram(0);
+
+    XPLMDebugString("FLIR: GLSL post-processing active\n");
+    return 1;
+}
+
+static void UploadTables(int screenWidth, int screenHeight, const PostShaderInputs* inputs)
+{
+    int allocate = !gTexturesReady;
+    if (!gTexturesReady) {
+        XPLMGenerateTextureNumbers(gTextures, UNIT_COUNT);
+        gTexturesReady = 1;
+    }
+
+    // Table rows are byte-packed; the sim's alignment is put back below
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // The frame itself: allocated on resize, filled by a device-side copy
+    BindLookupTexture(gTextures[UNIT_SCENE], allocate);
+    if (gSceneWidth != screenWidth || gSceneHeight != screenHeight) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, screenWidth, screenHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        gSceneWidth = screenWidth;
+        gSceneHeight = screenHeight;
+    }
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, screenWidth, screenHeight);
+
+    BindLookupTexture(gTextures[UNIT_TRANSFER], allocate);
+    if (gUploadedTransfer != inputs->transferVersion) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, FLIR_TRANSFER_SIZE, 3, 0, GL_RGB, GL_UNSIGNED_BYTE, inputs->transfer);
+        gUploadedTransfer = inputs->transferVersion;
+    }
+
+    // 8.8 transmission split into high and low bytes so it survives 8-bit storage
+    BindLookupTexture(gTextures[UNIT_ATTENUATION], allocate);
+    if (gUploadedAttenuation != inputs->attenuationVersion) {
+        unsigned char bytes[FLIR_RANGE_BUCKETS * 2];
+        for (int i = 0; i < FLIR_RANGE_BUCKETS; i++) {
+            bytes[i * 2] = (unsigned char)(inputs->attenuation[i] >> 8);
+            bytes[i * 2 + 1] = (unsigned char)(inputs->attenuation[i] & 0xFF);
+        }
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8_ALPHA8, FLIR_RANGE_BUCKETS, 1, 0,
+                     GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, bytes);
+        gUploadedAttenuation = inputs->attenuationVersion;
+    }
+
+    BindLookupTexture(gTextures[UNIT_RANGE], allocate);
+    if (inputs->rangeBuckets && gUploadedRange != inputs->rangeVersion) {
+        if (gRangeTextureWidth != inputs->rangeWidth || gRangeTextureHeight != inputs->rangeHeight) {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8, inputs->rangeWidth, inputs->rangeHeight, 0,
+                         GL_LUMINANCE, GL_UNSIGNED_BYTE, inputs->rangeBuckets);
+            gRangeTextureWidth = inputs->rangeWidth;
+            gRangeTextureHeight = inputs->rangeHeight;
+        } else {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, inputs->rangeWidth, inputs->rangeHeight,
+                            GL_LUMINANCE, GL_UNSIGNED_BYTE, inputs->rangeBuckets);
+        }
+        gUploadedRange = inputs->rangeVersion;
+    }
+
+    // Tiny and refreshed continuously by the classifier, so always re-sent
+    BindLookupTexture(gTextures[UNIT_TERRAIN], allocate);
+    if (inputs->terrainMask) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8, FLIR_TERRAIN_MASK_WIDTH, FLIR_TERRAIN_MASK_HEIGHT, 0,
+                     GL_LUMINANCE, GL_UNSIGNED_BYTE, inputs->terrainMask);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+    // Sampler units last, unit 0 at the end so that is the active one again
+    for (int unit = UNIT_COUNT - 1; unit >= 0; unit--) {
+        XPLMBindTexture2d(gTextures[unit], unit);
+    }
+}
+
+int RenderPostShader(int screenWidth, int screenHeight, const PostShaderInputs* inputs)
+{
+    if (gShaderFailed) return 0;
+
+    if (!gProgram) {
+        InitializeGLExtensions();
+        if (!HasShaders() || !BuildProgram()) {
+            gShaderFailed = 1;
+            return 0;
+        }
+    }
+
+    while (glGetError() != GL_NO_ERROR) { }
+
+    XPLMSetGraphicsState(0, UNIT_COUNT, 0, 0, 0, 0, 0);
+    UploadTables(screenWidth, screenHeight, inputs);
+
+    float heat[FLIR_MATERIAL_COUNT];
+    for (int i = 0; i < FLIR_MATERIAL_COUNT; i++) heat[i] = (float)inputs->materialHeat[i];
+
+    flirUseProgram(gProgram);
+    flirUniform1fv(gUniforms.heat, FLIR_MATERIAL_COUNT, heat);
+    flirUniform1f(gUniforms.mode, (float)(inputs->mode - 1));
+    flirUniform1f(gUniforms.pathLevel, (float)inputs->pathLevel);
+    flirUniform2f(gUniforms.screenSize, (float)screenWidth, (float)screenHeight);
+    if (inputs->rangeBuckets) {
+        flirUniform3f(gUniforms.rangeGrid, (float)inputs->rangeWidth, (float)inputs->rangeHeight,
+                      (float)inputs->rangeCell);
+    } else {
+        flirUniform3f(gUniforms.rangeGrid, 0.0f, 0.0f, 1.0f);
+    }
+    if (inputs->horizonPlane) {
+        flirUniform3f(gUniforms.horizon, inputs->horizonPlane[0], inputs->horizonPlane[1], inputs->horizonPlane[2]);
+    }
+    flirUniform1f(gUniforms.horizonValid, inputs->horizonPlane ? 1.0f : 0.0f);
+    flirUniform1f(gUniforms.terrainValid, inputs->terrainMask ? 1.0f : 0.0f);
+
+    DrawScreenQuad(screenWidth, screenHeight);
+
+    flirUseProgram(0);
+    XPLMSetGraphicsState(0, 0, 0, 0, 1, 0, 0);
+
+    if (glGetError() != GL_NO_ERROR) {
+        XPLMDebugString("FLIR: GLSL post-processing failed, falling back to the CPU path\n");
+        ReleasePostShader();
+        gShaderFailed = 1;
+        return 0;
+    }
+    return 1;
+}
+
+void ReleasePostShader()
+{
+    if (gProgram && flirDeleteProgram) {
+        flirDeleteProgram(gProgram);
+    }
+    if (gTexturesReady) {
+        GLuint textures[UNIT_COUNT];
+        for (int i = 0; i < UNIT_COUNT; i++) textures[i] = (GLuint)gTextures[i];
+        glDeleteTextures(UNIT_COUNT, textures);
+    }
+    gProgram = 0;
+    gTexturesReady = 0;
+    gSceneWidth = gSceneHeight = 0;
+    gRangeTextureWidth = gRangeTextureHeight = 0;
+    gUploadedTransfer = gUploadedAttenuation = gUploadedRange = -1;
+}
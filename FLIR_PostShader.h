@@ -0,0 +1,62 @@
+/*
+ * Header file for the GLSL post-processing path
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_POSTSHADER_H
+#define FLIR_POSTSHADER_H
+
+// Everything the fragment shader needs to reproduce ProcessEOIROptimized.
+// Versions let the module skip re-uploading tables that have not changed.
+typedef struct {
+    int mode;                           // 1 mono, 2 thermal, 3 IR
+    const int* materialHeat;            // FLIR_MATERIAL_COUNT gray offsets
+    int pathLevel;
+    const unsigned short* attenuation;  // FLIR_RANGE_BUCKETS, 8.8 fixed point
+    int attenuationVersion;
+    const unsigned char* transfer;      // 3 modes x FLIR_TRANSFER_SIZE RGB entries
+    int transferVersion;
+    const unsigned char* rangeBuckets;  // NULL when there is no valid range grid
+    int rangeWidth;
+    int rangeHeight;
+    int rangeCell;                      // Screen pixels per grid cell
+    int rangeVersion;
+    const float* horizonPlane;          // s = p[0] + p[1] * x + p[2] * y, sky where s > 0; NULL when unknown
+    const unsigned char* terrainMask;   // FLIR_TERRAIN_MASK_WIDTH x HEIGHT classes, NULL when unknown
+} PostShaderInputs;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Copies the frame into a texture and redraws it through the shader. Returns 0
+// when GLSL is unavailable or failed, so the caller can fall back to the CPU path.
+int RenderPostShader(int screenWidth, int screenHeight, const PostShaderInputs* inputs);
+void ReleasePostShader();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_POSTSHADER_H
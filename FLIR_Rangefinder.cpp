@@ -0,0 +1,179 @@
+/*
+ * Laser rangefinder: boresight terrain intersection amortised over flight loops and published to datarefs
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <math.h>
+
+#include "XPLMDataAccess.h"
+#include "XPLMGraphics.h"
+#include "XPLMProcessing.h"
+#include "FLIR_Rangefinder.h"
+#include "FLIR_Camera.h"
+#include "FLIR_RayCast.h"
+
+#define RANGEFINDER_MAX_RANGE 20000.0f
+#define RANGEFINDER_PROBE_BUDGET 24     // Real probes per flight loop while a ray is in flight
+
+static XPLMFlightLoopID gRangeLoop = NULL;
+static FLIRRangeReading gReading;
+static FLIRRayMarch gMarch;
+static int gFiring = 0;
+static float gFireTime = 0.0f;
+static float gLastFireTime = -1000.0f;
+static float gRate = 5.0f;
+
+static XPLMDataRef gValidRef = NULL;
+static XPLMDataRef gSlantRef = NULL;
+static XPLMDataRef gGroundRef = NULL;
+static XPLMDataRef gLatitudeRef = NULL;
+static XPLMDataRef gLongitudeRef = NULL;
+static XPLMDataRef gElevationRef = NULL;
+static XPLMDataRef gRateRef = NULL;
+
+static int GetValid(void* refcon) { return gReading.valid; }
+static float GetSlantRange(void* refcon) { return gReading.slantRange; }
+static float GetGroundRange(void* refcon) { return gReading.groundRange; }
+static double GetLatitude(void* refcon) { return gReading.latitude; }
+static double GetLongitude(void* refcon) { return gReading.longitude; }
+static double GetElevation(void* refcon) { return gReading.elevation; }
+static float GetRate(void* refcon) { return gRate; }
+static void SetRate(void* refcon, float value) { SetRangefinderRate(value); }
+
+static void PublishReading(const FLIRRayMarch* march)
+{
+    gReading.age = 0.0f;
+    if (march->status != RAY_HIT) {
+        gReading.valid = 0;
+        return;
+    }
+
+    float dx = march->x - march->origin[0];
+    float dz = march->z - march->origin[2];
+
+    gReading.slantRange = march->distance;
+    gReading.groundRange = sqrtf(dx * dx + dz * dz);
+    XPLMLocalToWorld(march->x, march->y, march->z,
+                     &gReading.latitude, &gReading.longitude, &gReading.elevation);
+    gReading.valid = 1;
+}
+
+static float RangeLoopCallback(float inElapsedSinceLastCall, float inElapsedTimeSinceLastFlightLoop,
+                               int inCounter, void* inRefcon)
+{
+    float now = XPLMGetElapsedTime();
+
+    FLIRCameraView view;
+    GetFLIRCameraView(&view);
+    if (!view.valid) {
+        gFiring = 0;
+        gReading.valid = 0;
+        return -1.0f;
+    }
+
+    // The reading describes where the boresight was when the ray was fired
+    if (!gFiring && now - gLastFireTime >= 1.0f / gRate) {
+        float origin[3] = { view.x, view.y, view.z };
+        BeginTerrainRay(&gMarch, origin, view.forward, RANGEFINDER_MAX_RANGE);
+        gFiring = 1;
+        gFireTime = now;
+        gLastFireTime = now;
+    }
+
+    if (gFiring && StepTerrainRay(&gMarch, RANGEFINDER_PROBE_BUDGET) != RAY_PENDING) {
+        PublishReading(&gMarch);
+        gFiring = 0;
+    }
+
+    gReading.age = now - gFireTime;
+    return -1.0f;
+}
+
+void InitializeRangefinder()
+{
+    memset(&gReading, 0, sizeof(gReading));
+    gFiring = 0;
+    gLastFireTime = -1000.0f;
+
+    gValidRef = XPLMRegisterDataAccessor("flir/rangefinder/valid", xplmType_Int, 0,
+                                         GetValid, NULL, NULL, NULL, NULL, NULL,
+                                         NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    gSlantRef = XPLMRegisterDataAccessor("flir/rangefinder/slant_range_m", xplmType_Float, 0,
+                                         NULL, NULL, GetSlantRange, NULL, NULL, NULL,
+                                         NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    gGroundRef = XPLMRegisterDataAccessor("flir/rangefinder/ground_range_m", xplmType_Float, 0,
+                                          NULL, NULL, GetGroundRange, NULL, NULL, NULL,
+                                          NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    gLatitudeRef = XPLMRegisterDataAccessor("flir/rangefinder/target_latitude", xplmType_Double, 0,
+                                            NULL, NULL, NULL, NULL, GetLatitude, NULL,
+                                            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    gLongitudeRef = XPLMRegisterDataAccessor("flir/rangefinder/target_longitude", xplmType_Double, 0,
+                                             NULL, NULL, NULL, NULL, GetLongitude, NULL,
+                                             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    gElevationRef = XPLMRegisterDataAccessor("flir/rangefinder/target_elevation_m", xplmType_Double, 0,
+                                             NULL, NULL, NULL, NULL, GetElevation, NULL,
+                                             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    gRateRef = XPLMRegisterDataAccessor("flir/rangefinder/rate_hz", xplmType_Float, 1,
+                                        NULL, NULL, GetRate, SetRate, NULL, NULL,
+                                        NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+    XPLMCreateFlightLoop_t params;
+    params.structSize = sizeof(params);
+    params.phase = xplm_FlightLoop_Phase_AfterFlightModel;
+    params.callbackFunc = RangeLoopCallback;
+    params.refcon = NULL;
+
+    gRangeLoop = XPLMCreateFlightLoop(&params);
+    XPLMScheduleFlightLoop(gRangeLoop, -1.0f, 1);
+}
+
+void CleanupRangefinder()
+{
+    if (gRangeLoop) {
+        XPLMDestroyFlightLoop(gRangeLoop);
+        gRangeLoop = NULL;
+    }
+
+    XPLMDataRef* refs[] = { &gValidRef, &gSlantRef, &gGroundRef, &gLatitudeRef,
+                            &gLongitudeRef, &gElevationRef, &gRateRef };
+    for (unsigned int i = 0; i < sizeof(refs) / sizeof(refs[0]); i++) {
+        if (*refs[i]) {
+            XPLMUnregisterDataAccessor(*refs[i]);
+            *refs[i] = NULL;
+        }
+    }
+}
+
+void SetRangefinderRate(float hz)
+{
+    if (hz < 0.5f) hz = 0.5f;
+    if (hz > 20.0f) hz = 20.0f;
+    gRate = hz;
+}
+
+void GetRangeReading(FLIRRangeReading* outReading)
+{
+    *outReading = gReading;
+}
@@ -0,0 +1,55 @@
+/*
+ * Header file for the laser rangefinder and target geolocation
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_RANGEFINDER_H
+#define FLIR_RANGEFINDER_H
+
+typedef struct {
+    int valid;                  // 0 until a ray has returned, or when nothing was hit
+    float slantRange;           // Meters along the boresight
+    float groundRange;          // Meters along the ground plane
+    double latitude;
+    double longitude;
+    double elevation;           // Meters MSL
+    float age;                  // Seconds since the ray that produced this was fired
+} FLIRRangeReading;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Publishes flir/rangefinder/* datarefs
+void InitializeRangefinder();
+void CleanupRangefinder();
+
+void SetRangefinderRate(float hz);
+void GetRangeReading(FLIRRangeReading* outReading);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_RANGEFINDER_H
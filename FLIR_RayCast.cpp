@@ -0,0 +1,338 @@
+/*
+ * Terrain ray marching with an adaptive step, bisection refinement and a cached local heightfield
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#include "XPLMDataAccess.h"
+#include "XPLMScenery.h"
+#include "XPLMGraphics.h"
+#include "FLIR_RayCast.h"
+
+#define RAYCAST_CELL 8.0f           // Heightfield sample spacing, meters
+#define RAYCAST_TILE 16             // Samples per tile side
+#define RAYCAST_TILE_SLOTS 256      // Direct-mapped, about 2 km square when full
+#define RAYCAST_NO_TERRAIN -1.0e30f
+
+#define RAYCAST_MIN_STEP 2.0f
+#define RAYCAST_MAX_STEP 500.0f
+#define RAYCAST_REFINE 0.5f         // Bisection stops at this bracket width
+
+enum {
+    RAYCAST_STAT_PROBES,
+    RAYCAST_STAT_LOOKUPS,
+    RAYCAST_STAT_HITS,
+    RAYCAST_STAT_HIT_RATE,
+    RAYCAST_STAT_COUNT
+};
+
+// Running totals since the plugin started, for watching the cache in DataRefTool
+static const char* gStatNames[RAYCAST_STAT_COUNT] = {
+    "flir/raycast/probes",
+    "flir/raycast/lookups",
+    "flir/raycast/hits",
+    "flir/raycast/hit_rate"
+};
+
+typedef struct {
+    int valid;
+    int tileX, tileZ;
+    unsigned int filled[RAYCAST_TILE * RAYCAST_TILE / 32];
+    float height[RAYCAST_TILE * RAYCAST_TILE];
+} HeightTile;
+
+static HeightTile gTiles[RAYCAST_TILE_SLOTS];
+static FLIRRayCastStats gStats;
+
+static XPLMProbeRef gProbe = NULL;
+static FLIRTerrainProbeFunc gProbeFunc = NULL;
+static void* gProbeRefcon = NULL;
+static XPLMDataRef gStatRefs[RAYCAST_STAT_COUNT];
+
+// The cache is keyed on local coordinates, which move when the sim shifts its origin
+static double gOriginLatitude = 0.0;
+static double gOriginLongitude = 0.0;
+
+static int ProbeXPLM(float x, float y, float z, float* outTerrainY, void* refcon)
+{
+    XPLMProbeInfo_t info;
+    info.structSize = sizeof(info);
+    if (!gProbe || XPLMProbeTerrainXYZ(gProbe, x, y, z, &info) != xplm_ProbeHitTerrain) {
+        return 0;
+    }
+    *outTerrainY = info.locationY;
+    return 1;
+}
+
+static int Probe(float x, float y, float z, float* outTerrainY)
+{
+    gStats.probes++;
+    return gProbeFunc(x, y, z, outTerrainY, gProbeRefcon);
+}
+
+static int GetStatCallback(void* inRefcon)
+{
+    switch ((int)(ptrdiff_t)inRefcon) {
+        case RAYCAST_STAT_PROBES: return (int)gStats.probes;
+        case RAYCAST_STAT_LOOKUPS: return (int)gStats.lookups;
+        case RAYCAST_STAT_HITS: return (int)gStats.hits;
+        default: return 0;
+    }
+}
+
+static float GetHitRateCallback(void* inRefcon)
+{
+    return gStats.hitRate;
+}
+
+static int FloorDiv(int value, int divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+static float SampleHeight(int ix, int iz, float probeY)
+{
+    int tileX = FloorDiv(ix, RAYCAST_TILE);
+    int tileZ = FloorDiv(iz, RAYCAST_TILE);
+    unsigned int slot = ((unsigned int)tileX * 73856093u ^ (unsigned int)tileZ * 19349663u) & (RAYCAST_TILE_SLOTS - 1);
+
+    HeightTile* tile = &gTiles[slot];
+    if (!tile->valid || tile->tileX != tileX || tile->tileZ != tileZ) {
+        tile->valid = 1;
+        tile->tileX = tileX;
+        tile->tileZ = tileZ;
+        memset(tile->filled, 0, sizeof(tile->filled));
+    }
+
+    int index = (iz - tileZ * RAYCAST_TILE) * RAYCAST_TILE + (ix - tileX * RAYCAST_TILE);
+    unsigned int bit = 1u << (index & 31);
+
+    gStats.lookups++;
+    if (tile->filled[index >> 5] & bit) {
+        gStats.hits++;
+        return tile->height[index];
+    }
+
+    float terrainY;
+    if (!Probe(ix * RAYCAST_CELL, probeY, iz * RAYCAST_CELL, &terrainY)) {
+        terrainY = RAYCAST_NO_TERRAIN;
+    }
+    tile->height[index] = terrainY;
+    tile->filled[index >> 5] |= bit;
+    return terrainY;
+}
+
+// Bilinear height from the cached grid; 0 where any corner is off the mesh
+static int CachedTerrainY(float x, float y, float z, float* outTerrainY)
+{
+    float gx = x / RAYCAST_CELL;
+    float gz = z / RAYCAST_CELL;
+    int ix = (int)floorf(gx);
+    int iz = (int)floorf(gz);
+    float fx = gx - ix;
+    float fz = gz - iz;
+
+    float h00 = SampleHeight(ix, iz, y);
+    float h10 = SampleHeight(ix + 1, iz, y);
+    float h01 = SampleHeight(ix, iz + 1, y);
+    float h11 = SampleHeight(ix + 1, iz + 1, y);
+    if (h00 == RAYCAST_NO_TERRAIN || h10 == RAYCAST_NO_TERRAIN ||
+        h01 == RAYCAST_NO_TERRAIN || h11 == RAYCAST_NO_TERRAIN) {
+        return 0;
+    }
+
+    float top = h00 + (h10 - h00) * fx;
+    float bottom = h01 + (h11 - h01) * fx;
+    *outTerrainY = top + (bottom - top) * fz;
+    return 1;
+}
+
+void InitializeRayCast()
+{
+    memset(gTiles, 0, sizeof(gTiles));
+    memset(&gStats, 0, sizeof(gStats));
+    gProbe = XPLMCreateProbe(xplm_ProbeY);
+    SetRayCastProbe(NULL, NULL);
+
+    for (int stat = 0; stat < RAYCAST_STAT_HIT_RATE; stat++) {
+        gStatRefs[stat] = XPLMRegisterDataAccessor(gStatNames[stat], xplmType_Int, 0,
+                                                   GetStatCallback, NULL,
+                                                   NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                                   (void*)(ptrdiff_t)stat, NULL);
+    }
+    gStatRefs[RAYCAST_STAT_HIT_RATE] = XPLMRegisterDataAccessor(gStatNames[RAYCAST_STAT_HIT_RATE], xplmType_Float, 0,
+                                                                NULL, NULL,
+                                                                GetHitRateCallback, NULL,
+                                                                NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                                                NULL, NULL);
+}
+
+void CleanupRayCast()
+{
+    for (int stat = 0; stat < RAYCAST_STAT_COUNT; stat++) {
+        if (gStatRefs[stat]) {
+            XPLMUnregisterDataAccessor(gStatRefs[stat]);
+            gStatRefs[stat] = NULL;
+        }
+    }
+
+    if (gProbe) {
+        XPLMDestroyProbe(gProbe);
+        gProbe = NULL;
+    }
+}
+
+void SetRayCastProbe(FLIRTerrainProbeFunc func, void* refcon)
+{
+    gProbeFunc = func ? func : ProbeXPLM;
+    gProbeRefcon = func ? refcon : NULL;
+    InvalidateRayCastCache();
+}
+
+void InvalidateRayCastCache()
+{
+    for (int i = 0; i < RAYCAST_TILE_SLOTS; i++) {
+        gTiles[i].valid = 0;
+    }
+}
+
+void BeginTerrainRay(FLIRRayMarch* march, const float origin[3], const float dir[3], float maxRange)
+{
+    if (gProbeFunc == ProbeXPLM) {
+        double latitude, longitude, altitude;
+        XPLMLocalToWorld(0.0, 0.0, 0.0, &latitude, &longitude, &altitude);
+        if (latitude != gOriginLatitude || longitude != gOriginLongitude) {
+            gOriginLatitude = latitude;
+            gOriginLongitude = longitude;
+            InvalidateRayCastCache();
+        }
+    }
+
+    memset(march, 0, sizeof(*march));
+    memcpy(march->origin, origin, sizeof(march->origin));
+    memcpy(march->dir, dir, sizeof(march->dir));
+    march->maxRange = maxRange;
+    march->status = RAY_PENDING;
+}
+
+int StepTerrainRay(FLIRRayMarch* march, int probeBudget)
+{
+    unsigned int start = gStats.probes;
+
+    while (march->status == RAY_PENDING && (int)(gStats.probes - start) < probeBudget) {
+        if (!march->bracketed) {
+            float t = march->far;
+            float x = march->origin[0] + march->dir[0] * t;
+            float y = march->origin[1] + march->dir[1] * t;
+            float z = march->origin[2] + march->dir[2] * t;
+
+            float terrainY;
+            float gap = RAYCAST_MAX_STEP;
+            if (CachedTerrainY(x, y, z, &terrainY)) {
+                gap = y - terrainY;
+            }
+
+            if (gap <= 0.0f) {
+                if (t == 0.0f) {
+                    march->status = RAY_MISS;   // Starts below the surface
+                } else {
+                    march->bracketed = 1;
+                }
+                continue;
+            }
+            if (t >= march->maxRange) {
+                march->status = RAY_MISS;
+                continue;
+            }
+
+            // Terrain up to 45 degrees cannot close a gap faster than 1.5 m per
+            // meter of ray, so this step never jumps a surface that steep
+            float step = gap / 1.5f;
+            if (step < RAYCAST_MIN_STEP) step = RAYCAST_MIN_STEP;
+            if (step > RAYCAST_MAX_STEP) step = RAYCAST_MAX_STEP;
+
+            march->near = t;
+            march->far = t + step < march->maxRange ? t + step : march->maxRange;
+        } else if (march->far - march->near > RAYCAST_REFINE) {
+            // Refine against the real surface rather than the interpolated grid
+            float mid = (march->near + march->far) * 0.5f;
+            float x = march->origin[0] + march->dir[0] * mid;
+            float y = march->origin[1] + march->dir[1] * mid;
+            float z = march->origin[2] + march->dir[2] * mid;
+
+            float terrainY;
+            if (Probe(x, y, z, &terrainY) && y <= terrainY) {
+                march->far = mid;
+            } else {
+                march->near = mid;
+            }
+        } else {
+            march->distance = march->far;
+            march->x = march->origin[0] + march->dir[0] * march->far;
+            march->y = march->origin[1] + march->dir[1] * march->far;
+            march->z = march->origin[2] + march->dir[2] * march->far;
+            march->status = RAY_HIT;
+        }
+    }
+
+    march->probes += gStats.probes - start;
+    gStats.hitRate = gStats.lookups ? (float)gStats.hits / gStats.lookups : 0.0f;
+    return march->status;
+}
+
+int CastTerrainRay(const float origin[3], const float dir[3], float maxRange, FLIRRayMarch* outMarch)
+{
+    BeginTerrainRay(outMarch, origin, dir, maxRange);
+    while (StepTerrainRay(outMarch, 64) == RAY_PENDING) {
+    }
+    return outMarch->status;
+}
+
+int IsLineOfSightClear(const float from[3], const float to[3])
+{
+    float dir[3] = { to[0] - from[0], to[1] - from[1], to[2] - from[2] };
+    float length = sqrtf(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+    if (length <= RAYCAST_REFINE * 4.0f) return 1;
+
+    dir[0] /= length;
+    dir[1] /= length;
+    dir[2] /= length;
+
+    // Stop short so a target sitting on the ground does not occlude itself
+    FLIRRayMarch march;
+    return CastTerrainRay(from, dir, length - RAYCAST_REFINE * 4.0f, &march) != RAY_HIT;
+}
+
+void GetRayCastStats(FLIRRayCastStats* outStats)
+{
+    *outStats = gStats;
+}
+
+void ResetRayCastStats()
+{
+    memset(&gStats, 0, sizeof(gStats));
+}
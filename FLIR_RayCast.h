@@ -0,0 +1,85 @@
+/*
+ * Header file for the cached terrain ray-marching engine
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_RAYCAST_H
+#define FLIR_RAYCAST_H
+
+// Height of terrain below (x, y, z) in local coordinates; returns 0 off the mesh
+typedef int (*FLIRTerrainProbeFunc)(float x, float y, float z, float* outTerrainY, void* refcon);
+
+enum {
+    RAY_PENDING = 0,
+    RAY_HIT = 1,
+    RAY_MISS = 2
+};
+
+// A march in progress, so long casts can be spread over several frames
+typedef struct {
+    int status;
+    float origin[3];
+    float dir[3];               // Unit length
+    float maxRange;
+    float near, far;            // Bracket; the hit lies in (near, far] once found
+    int bracketed;
+    float x, y, z;              // Hit point once status is RAY_HIT
+    float distance;
+    int probes;                 // Real probes spent on this ray
+} FLIRRayMarch;
+
+typedef struct {
+    unsigned int probes;        // Calls into the probe function
+    unsigned int lookups;       // Heightfield samples requested
+    unsigned int hits;          // ... of which were already cached
+    float hitRate;
+} FLIRRayCastStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void InitializeRayCast();
+void CleanupRayCast();
+
+// NULL restores XPLMProbeTerrainXYZ; a synthetic heightfield can be swapped in here
+void SetRayCastProbe(FLIRTerrainProbeFunc func, void* refcon);
+void InvalidateRayCastCache();
+
+void BeginTerrainRay(FLIRRayMarch* march, const float origin[3], const float dir[3], float maxRange);
+// Runs until the ray resolves or probeBudget real probes are spent; cached samples are free
+int StepTerrainRay(FLIRRayMarch* march, int probeBudget);
+
+// Blocking conveniences built on the above
+int CastTerrainRay(const float origin[3], const float dir[3], float maxRange, FLIRRayMarch* outMarch);
+int IsLineOfSightClear(const float from[3], const float to[3]);
+
+void GetRayCastStats(FLIRRayCastStats* outStats);
+void ResetRayCastStats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_RAYCAST_H
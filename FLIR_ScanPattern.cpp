@@ -0,0 +1,296 @@
+/*
+ * Automated sector, raster and spiral scans advanced on a flight loop and fed to the gimbal
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "XPLMDataAccess.h"
+#include "XPLMGraphics.h"
+#include "XPLMProcessing.h"
+#include "FLIR_ScanPattern.h"
+#include "FLIR_Camera.h"
+#include "FLIR_Mount.h"
+#include "FLIR_Gimbal.h"
+#include "FLIR_RayCast.h"
+#include "FLIR_SimpleLock.h"
+
+#define SCAN_MAX_WAYPOINTS 128
+#define SCAN_GEO_RANGE 20000.0f
+
+// Pattern shapes, degrees of pan/tilt around the centre
+#define SECTOR_WIDTH 90.0f
+#define RASTER_WIDTH 60.0f
+#define RASTER_BARS 4
+#define RASTER_BAR_SPACING 3.0f
+#define SPIRAL_RADIUS 10.0f
+#define SPIRAL_TURNS 4
+#define SPIRAL_POINTS_PER_TURN 24
+
+typedef struct {
+    float pan, tilt;
+} ScanWaypoint;
+
+static const char* gPatternNames[SCAN_PATTERN_COUNT] = { "OFF", "SECTOR", "RASTER", "SPIRAL" };
+
+static XPLMFlightLoopID gScanLoop = NULL;
+static int gPattern = SCAN_OFF;
+static float gRate = 20.0f;             // Degrees per second along the path
+static int gGeoFixed = 0;
+
+// The path is a closed loop: the last waypoint leads back to the first
+static ScanWaypoint gWaypoints[SCAN_MAX_WAYPOINTS];
+static int gWaypointCount = 0;
+static int gSegment = 0;
+static float gSegmentProgress = 0.0f;   // Degrees travelled along the current segment
+
+static float gCenterPan = 0.0f;
+static float gCenterTilt = 0.0f;
+static int gCenterGeo = 0;
+static double gCenterLatitude = 0.0;
+static double gCenterLongitude = 0.0;
+static double gCenterAltitude = 0.0;
+
+static XPLMDataRef gPatternRef = NULL;
+static XPLMDataRef gRateRef = NULL;
+static XPLMDataRef gGeoFixedRef = NULL;
+
+static int GetPatternRef(void* refcon) { return gPattern; }
+static void SetPatternRef(void* refcon, int value) { StartScan(value); }
+static float GetRateRef(void* refcon) { return gRate; }
+static void SetRateRef(void* refcon, float value) { SetScanRate(value); }
+static int GetGeoFixedRef(void* refcon) { return gGeoFixed; }
+static void SetGeoFixedRef(void* refcon, int value) { SetScanGeoFixed(value); }
+
+static void AddWaypoint(float pan, float tilt)
+{
+    if (gWaypointCount >= SCAN_MAX_WAYPOINTS) return;
+    gWaypoints[gWaypointCount].pan = pan;
+    gWaypoints[gWaypointCount].tilt = tilt;
+    gWaypointCount++;
+}
+
+static void BuildWaypoints(int pattern)
+{
+    gWaypointCount = 0;
+
+    switch (pattern) {
+        case SCAN_SECTOR:
+            AddWaypoint(-SECTOR_WIDTH * 0.5f, 0.0f);
+            AddWaypoint(SECTOR_WIDTH * 0.5f, 0.0f);
+            break;
+
+        case SCAN_RASTER: {
+            // Serpentine bars top to bottom; closing the loop flies back up
+            float top = (RASTER_BARS - 1) * RASTER_BAR_SPACING * 0.5f;
+            for (int bar = 0; bar < RASTER_BARS; bar++) {
+                float tilt = top - bar * RASTER_BAR_SPACING;
+                float start = (bar & 1) ? RASTER_WIDTH * 0.5f : -RASTER_WIDTH * 0.5f;
+                AddWaypoint(start, tilt);
+                AddWaypoint(-start, tilt);
+            }
+            break;
+        }
+
+        case SCAN_SPIRAL: {
+            // Archimedean spiral out from the centre; closing the loop returns to it
+            int points = SPIRAL_TURNS * SPIRAL_POINTS_PER_TURN;
+            for (int i = 0; i <= points; i++) {
+                float t = (float)i / points;
+                float angle = t * SPIRAL_TURNS * 2.0f * (float)M_PI;
+                AddWaypoint(SPIRAL_RADIUS * t * cosf(angle), SPIRAL_RADIUS * t * sinf(angle));
+            }
+            break;
+        }
+    }
+}
+
+static void CaptureCenter()
+{
+    FLIRCameraView view;
+    GetFLIRCameraView(&view);
+    GetGimbalAngles(&gCenterPan, &gCenterTilt);
+
+    gCenterGeo = 0;
+    if (!gGeoFixed || !view.valid) return;
+
+    float origin[3] = { view.x, view.y, view.z };
+    FLIRRayMarch march;
+    if (CastTerrainRay(origin, view.forward, SCAN_GEO_RANGE, &march) == RAY_HIT) {
+        XPLMLocalToWorld(march.x, march.y, march.z, &gCenterLatitude, &gCenterLongitude, &gCenterAltitude);
+        gCenterGeo = 1;
+    }
+}
+
+static void CurrentCenter(float* outPan, float* outTilt)
+{
+    *outPan = gCenterPan;
+    *outTilt = gCenterTilt;
+
+    const FLIRMount* mount = GetMount();
+    if (!gCenterGeo || !mount->valid) return;
+
+    double x, y, z;
+    XPLMWorldToLocal(gCenterLatitude, gCenterLongitude, gCenterAltitude, &x, &y, &z);
+    float dir[3] = { (float)(x - mount->x), (float)(y - mount->y), (float)(z - mount->z) };
+    LocalDirectionToGimbal(dir, outPan, outTilt);
+}
+
+static float ScanLoopCallback(float inElapsedSinceLastCall, float inElapsedTimeSinceLastFlightLoop,
+                              int inCounter, void* inRefcon)
+{
+    if (gPattern == SCAN_OFF || gWaypointCount < 2) return -1.0f;
+
+    FLIRCameraView view;
+    GetFLIRCameraView(&view);
+    if (!view.valid) {
+        StopScan();
+        return -1.0f;
+    }
+
+    // An acquired lock owns the gimbal; the scan holds its place until released
+    if (IsSimpleLockActive()) return -1.0f;
+
+    float distance = gSegmentProgress + gRate * inElapsedSinceLastCall;
+    const ScanWaypoint* from;
+    const ScanWaypoint* to;
+    float length;
+    for (;;) {
+        from = &gWaypoints[gSegment];
+        to = &gWaypoints[(gSegment + 1) % gWaypointCount];
+        float dp = to->pan - from->pan;
+        float dt = to->tilt - from->tilt;
+        length = sqrtf(dp * dp + dt * dt);
+        if (distance < length) break;
+        distance -= length;
+        gSegment = (gSegment + 1) % gWaypointCount;
+    }
+    gSegmentProgress = distance;
+
+    float t = length > 0.0f ? distance / length : 0.0f;
+    float centerPan, centerTilt;
+    CurrentCenter(&centerPan, &centerTilt);
+
+    SetGimbalTarget(centerPan + from->pan + (to->pan - from->pan) * t,
+                    centerTilt + from->tilt + (to->tilt - from->tilt) * t);
+
+    return -1.0f;
+}
+
+void InitializeScanPattern()
+{
+    gPattern = SCAN_OFF;
+    gWaypointCount = 0;
+
+    gPatternRef = XPLMRegisterDataAccessor("flir/scan/pattern", xplmType_Int, 1,
+                                           GetPatternRef, SetPatternRef, NULL, NULL, NULL, NULL,
+                                           NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    gRateRef = XPLMRegisterDataAccessor("flir/scan/rate_dps", xplmType_Float, 1,
+                                        NULL, NULL, GetRateRef, SetRateRef, NULL, NULL,
+                                        NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    gGeoFixedRef = XPLMRegisterDataAccessor("flir/scan/geo_fixed", xplmType_Int, 1,
+                                            GetGeoFixedRef, SetGeoFixedRef, NULL, NULL, NULL, NULL,
+                                            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+    XPLMCreateFlightLoop_t params;
+    params.structSize = sizeof(params);
+    params.phase = xplm_FlightLoop_Phase_AfterFlightModel;
+    params.callbackFunc = ScanLoopCallback;
+    params.refcon = NULL;
+
+    gScanLoop = XPLMCreateFlightLoop(&params);
+    XPLMScheduleFlightLoop(gScanLoop, -1.0f, 1);
+}
+
+void CleanupScanPattern()
+{
+    if (gScanLoop) {
+        XPLMDestroyFlightLoop(gScanLoop);
+        gScanLoop = NULL;
+    }
+
+    XPLMDataRef* refs[] = { &gPatternRef, &gRateRef, &gGeoFixedRef };
+    for (unsigned int i = 0; i < sizeof(refs) / sizeof(refs[0]); i++) {
+        if (*refs[i]) {
+            XPLMUnregisterDataAccessor(*refs[i]);
+            *refs[i] = NULL;
+        }
+    }
+}
+
+void StartScan(int pattern)
+{
+    if (pattern <= SCAN_OFF || pattern >= SCAN_PATTERN_COUNT) {
+        StopScan();
+        return;
+    }
+
+    BuildWaypoints(pattern);
+    CaptureCenter();
+    gSegment = 0;
+    gSegmentProgress = 0.0f;
+    gPattern = pattern;
+}
+
+void StopScan()
+{
+    gPattern = SCAN_OFF;
+}
+
+void CycleScanPattern()
+{
+    StartScan((gPattern + 1) % SCAN_PATTERN_COUNT);
+}
+
+int IsScanActive()
+{
+    return gPattern != SCAN_OFF;
+}
+
+int GetScanPattern()
+{
+    return gPattern;
+}
+
+const char* GetScanPatternName()
+{
+    return gPatternNames[gPattern];
+}
+
+void SetScanGeoFixed(int geoFixed)
+{
+    gGeoFixed = geoFixed ? 1 : 0;
+}
+
+void SetScanRate(float degreesPerSecond)
+{
+    if (degreesPerSecond < 1.0f) degreesPerSecond = 1.0f;
+    if (degreesPerSecond > 90.0f) degreesPerSecond = 90.0f;
+    gRate = degreesPerSecond;
+}
@@ -0,0 +1,64 @@
+/*
+ * Header file for the automated turret scan patterns
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_SCANPATTERN_H
+#define FLIR_SCANPATTERN_H
+
+enum {
+    SCAN_OFF = 0,
+    SCAN_SECTOR,
+    SCAN_RASTER,
+    SCAN_SPIRAL,
+    SCAN_PATTERN_COUNT
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Publishes flir/scan/* datarefs
+void InitializeScanPattern();
+void CleanupScanPattern();
+
+// Starts around the current line of sight; SCAN_OFF stops
+void StartScan(int pattern);
+void StopScan();
+void CycleScanPattern();
+
+int IsScanActive();
+int GetScanPattern();
+const char* GetScanPatternName();
+
+// Geo-fixed scans centre on the terrain point under the reticle at start and
+// stay on it as the aircraft moves; otherwise the pattern rides the airframe
+void SetScanGeoFixed(int geoFixed);
+void SetScanRate(float degreesPerSecond);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_SCANPATTERN_H
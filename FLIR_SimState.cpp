@@ -0,0 +1,175 @@
+/*
+ * Per-frame sim state snapshot, one dataref read per value per sim frame
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "XPLMDataAccess.h"
+#include "XPLMDisplay.h"
+#include "XPLMProcessing.h"
+#include "XPLMUtilities.h"
+#include "FLIR_SimState.h"
+
+static XPLMFlightLoopID gSnapshotLoop = NULL;
+static FLIRSimState gState;
+
+static struct {
+    XPLMDataRef localX, localY, localZ;
+    XPLMDataRef latitude, longitude, elevation;
+    XPLMDataRef heading, pitch, roll, quaternion;
+    XPLMDataRef rollRate, pitchRate, yawRate;
+    XPLMDataRef velocityX, velocityY, velocityZ, groundSpeed;
+    XPLMDataRef zuluTime, localTime, sunPitch;
+    XPLMDataRef viewType, fieldOfView, uiScale;
+} gRefs;
+
+static float ReadFloat(XPLMDataRef ref, float fallback)
+{
+    return ref ? XPLMGetDataf(ref) : fallback;
+}
+
+static double ReadDouble(XPLMDataRef ref)
+{
+    return ref ? XPLMGetDatad(ref) : 0.0;
+}
+
+void RefreshSimState()
+{
+    FLIRSimState* s = &gState;
+
+    s->localX = ReadFloat(gRefs.localX, 0.0f);
+    s->localY = ReadFloat(gRefs.localY, 0.0f);
+    s->localZ = ReadFloat(gRefs.localZ, 0.0f);
+    s->latitude = ReadDouble(gRefs.latitude);
+    s->longitude = ReadDouble(gRefs.longitude);
+    s->elevation = ReadDouble(gRefs.elevation);
+
+    s->heading = ReadFloat(gRefs.heading, 0.0f);
+    s->pitch = ReadFloat(gRefs.pitch, 0.0f);
+    s->roll = ReadFloat(gRefs.roll, 0.0f);
+    if (!gRefs.quaternion || XPLMGetDatavf(gRefs.quaternion, s->quaternion, 0, 4) != 4) {
+        s->quaternion[0] = 1.0f;
+        s->quaternion[1] = s->quaternion[2] = s->quaternion[3] = 0.0f;
+    }
+    s->rollRate = ReadFloat(gRefs.rollRate, 0.0f);
+    s->pitchRate = ReadFloat(gRefs.pitchRate, 0.0f);
+    s->yawRate = ReadFloat(gRefs.yawRate, 0.0f);
+
+    s->velocityX = ReadFloat(gRefs.velocityX, 0.0f);
+    s->velocityY = ReadFloat(gRefs.velocityY, 0.0f);
+    s->velocityZ = ReadFloat(gRefs.velocityZ, 0.0f);
+    s->groundSpeed = ReadFloat(gRefs.groundSpeed, 0.0f);
+
+    s->zuluTime = ReadFloat(gRefs.zuluTime, 0.0f);
+    s->localTime = ReadFloat(gRefs.localTime, 0.0f);
+    s->sunPitch = ReadFloat(gRefs.sunPitch, 0.0f);
+
+    s->viewType = gRefs.viewType ? XPLMGetDatai(gRefs.viewType) : 0;
+    s->fieldOfView = ReadFloat(gRefs.fieldOfView, 60.0f);
+    s->uiScale = ReadFloat(gRefs.uiScale, 1.0f);
+    XPLMGetScreenSize(&s->screenWidth, &s->screenHeight);
+
+    // Repeat captures within a frame and long stalls stay out of the average
+    float now = XPLMGetElapsedTime();
+    float delta = now - s->elapsed;
+    if (s->valid && delta > 0.0f && delta < 0.25f) {
+        s->frameTime = s->frameTime > 0.0f ? s->frameTime + (delta - s->frameTime) * 0.1f : delta;
+    }
+
+    s->cycle = XPLMGetCycleNumber();
+    s->elapsed = now;
+    s->valid = gRefs.localX && gRefs.localY && gRefs.localZ && gRefs.heading && gRefs.pitch && gRefs.roll;
+}
+
+static float SnapshotLoopCallback(float inElapsedSinceLastCall, float inElapsedTimeSinceLastFlightLoop,
+                                  int inCounter, void* inRefcon)
+{
+    // A per-frame consumer may already have captured this frame
+    if (!gState.valid || GetSimStateAge() != 0) {
+        RefreshSimState();
+    }
+    return -1.0f; // Every sim frame
+}
+
+void InitializeSimState()
+{
+    memset(&gState, 0, sizeof(gState));
+
+    gRefs.localX = XPLMFindDataRef("sim/flightmodel/position/local_x");
+    gRefs.localY = XPLMFindDataRef("sim/flightmodel/position/local_y");
+    gRefs.localZ = XPLMFindDataRef("sim/flightmodel/position/local_z");
+    gRefs.latitude = XPLMFindDataRef("sim/flightmodel/position/latitude");
+    gRefs.longitude = XPLMFindDataRef("sim/flightmodel/position/longitude");
+    gRefs.elevation = XPLMFindDataRef("sim/flightmodel/position/elevation");
+    gRefs.heading = XPLMFindDataRef("sim/flightmodel/position/psi");
+    gRefs.pitch = XPLMFindDataRef("sim/flightmodel/position/theta");
+    gRefs.roll = XPLMFindDataRef("sim/flightmodel/position/phi");
+    gRefs.quaternion = XPLMFindDataRef("sim/flightmodel/position/q");
+    gRefs.rollRate = XPLMFindDataRef("sim/flightmodel/position/P");
+    gRefs.pitchRate = XPLMFindDataRef("sim/flightmodel/position/Q");
+    gRefs.yawRate = XPLMFindDataRef("sim/flightmodel/position/R");
+    gRefs.velocityX = XPLMFindDataRef("sim/flightmodel/position/local_vx");
+    gRefs.velocityY = XPLMFindDataRef("sim/flightmodel/position/local_vy");
+    gRefs.velocityZ = XPLMFindDataRef("sim/flightmodel/position/local_vz");
+    gRefs.groundSpeed = XPLMFindDataRef("sim/flightmodel/position/groundspeed");
+    gRefs.zuluTime = XPLMFindDataRef("sim/time/zulu_time_sec");
+    gRefs.localTime = XPLMFindDataRef("sim/time/local_time_sec");
+    gRefs.sunPitch = XPLMFindDataRef("sim/graphics/scenery/sun_pitch_degrees");
+    gRefs.viewType = XPLMFindDataRef("sim/graphics/view/view_type");
+    gRefs.fieldOfView = XPLMFindDataRef("sim/graphics/view/field_of_view_deg");
+    gRefs.uiScale = XPLMFindDataRef("sim/graphics/misc/user_interface_scale");
+
+    // Same phase as the subsystem loops. The SDK does not order loops within a
+    // phase, so per-frame consumers that need this frame's pose (the gimbal)
+    // check GetSimStateAge() and refresh early themselves
+    XPLMCreateFlightLoop_t params;
+    params.structSize = sizeof(params);
+    params.phase = xplm_FlightLoop_Phase_AfterFlightModel;
+    params.callbackFunc = SnapshotLoopCallback;
+    params.refcon = NULL;
+
+    gSnapshotLoop = XPLMCreateFlightLoop(&params);
+    XPLMScheduleFlightLoop(gSnapshotLoop, -1.0f, 1);
+}
+
+void CleanupSimState()
+{
+    if (gSnapshotLoop) {
+        XPLMDestroyFlightLoop(gSnapshotLoop);
+        gSnapshotLoop = NULL;
+    }
+    gState.valid = 0;
+}
+
+const FLIRSimState* GetSimState()
+{
+    return &gState;
+}
+
+int GetSimStateAge()
+{
+    return XPLMGetCycleNumber() - gState.cycle;
+}
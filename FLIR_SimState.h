@@ -0,0 +1,82 @@
+/*
+ * Header file for the per-frame sim state snapshot
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_SIMSTATE_H
+#define FLIR_SIMSTATE_H
+
+// Everything the plugin reads from the sim, captured once per sim frame.
+// Subsystems read this instead of touching datarefs themselves.
+typedef struct {
+    int valid;
+    int cycle;                  // XPLMGetCycleNumber when captured
+    float elapsed;              // XPLMGetElapsedTime when captured
+    float frameTime;            // Smoothed seconds between snapshots
+
+    // Position
+    float localX, localY, localZ;   // Local OpenGL coordinates
+    double latitude, longitude;
+    double elevation;               // Meters MSL
+
+    // Attitude, degrees, plus the flight model's own quaternion (w, x, y, z)
+    float heading, pitch, roll;
+    float quaternion[4];
+    float rollRate, pitchRate, yawRate;     // P, Q, R in degrees per second
+
+    // Velocities, meters per second
+    float velocityX, velocityY, velocityZ;  // Local OpenGL axes
+    float groundSpeed;
+
+    // Time
+    float zuluTime;             // Seconds since midnight
+    float localTime;
+    float sunPitch;             // Degrees above the horizon
+
+    // View
+    int viewType;
+    float fieldOfView;          // Sim's horizontal field of view in degrees
+    float uiScale;
+    int screenWidth, screenHeight;
+} FLIRSimState;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void InitializeSimState();
+void CleanupSimState();
+
+// Captures immediately, for callers that run before the first flight loop
+void RefreshSimState();
+const FLIRSimState* GetSimState();
+
+// Sim frames since the snapshot was taken; 0 means it is current
+int GetSimStateAge();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_SIMSTATE_H
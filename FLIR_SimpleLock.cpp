@@ -35,21 +35,78 @@
 
 #include "XPLMDataAccess.h"
 #include "XPLMUtilities.h"
+#include "XPLMGraphics.h"
 #include "FLIR_SimpleLock.h"
+#include "FLIR_Camera.h"
+#include "FLIR_Mount.h"
+#include "FLIR_RayCast.h"
 
 static int gLockActive = 0;
+static int gLockMode = LOCK_MODE_DIRECTION;
 static float gLockedPan = 0.0f;
 static float gLockedTilt = 0.0f;
 
+// Geo-lock target, kept in world coordinates so it survives the sim
+// shifting its local origin
+static double gLockLatitude = 0.0;
+static double gLockLongitude = 0.0;
+static double gLockAltitude = 0.0;
+
+static float gMaxLockRange = 20000.0f;     // Meters along the boresight
+
 void InitializeSimpleLock()
 {
     gLockActive = 0;
+    gLockMode = LOCK_MODE_DIRECTION;
+}
+
+static int CastBoresight(const FLIRCameraView* view, float* outX, float* outY, float* outZ)
+{
+    float origin[3] = { view->x, view->y, view->z };
+    FLIRRayMarch march;
+    if (CastTerrainRay(origin, view->forward, gMaxLockRange, &march) != RAY_HIT) return 0;
+
+    *outX = march.x;
+    *outY = march.y;
+    *outZ = march.z;
+    return 1;
+}
+
+int LockBoresightPoint()
+{
+    FLIRCameraView view;
+    GetFLIRCameraView(&view);
+    if (!view.valid) return 0;
+
+    float x, y, z;
+    if (!CastBoresight(&view, &x, &y, &z)) return 0;
+
+    XPLMLocalToWorld(x, y, z, &gLockLatitude, &gLockLongitude, &gLockAltitude);
+    gLockMode = LOCK_MODE_GEO;
+    gLockActive = 1;
+    return 1;
+}
+
+int GetLockedWorldPoint(double* outLatitude, double* outLongitude, double* outAltitude)
+{
+    if (!gLockActive || gLockMode != LOCK_MODE_GEO) return 0;
+
+    *outLatitude = gLockLatitude;
+    *outLongitude = gLockLongitude;
+    *outAltitude = gLockAltitude;
+    return 1;
+}
+
+int GetSimpleLockMode()
+{
+    return gLockMode;
 }
 
 void LockCurrentDirection(float currentPan, float currentTilt)
 {
     gLockedPan = currentPan;
     gLockedTilt = currentTilt;
+    gLockMode = LOCK_MODE_DIRECTION;
     gLockActive = 1;
 }
 
@@ -59,6 +116,17 @@ void GetLockedAngles(float* outPan, float* outTilt)
         return;
     }
     
+    if (gLockMode == LOCK_MODE_GEO) {
+        // One world-to-local conversion and a matrix transpose per frame
+        const FLIRMount* mount = GetMount();
+        if (!mount->valid) return;
+
+        double x, y, z;
+        XPLMWorldToLocal(gLockLatitude, gLockLongitude, gLockAltitude, &x, &y, &z);
+        float dir[3] = { (float)(x - mount->x), (float)(y - mount->y), (float)(z - mount->z) };
+        LocalDirectionToGimbal(dir, &gLockedPan, &gLockedTilt);
+    }
+    
     *outPan = gLockedPan;
     *outTilt = gLockedTilt;
 }
@@ -81,6 +149,10 @@ void GetSimpleLockStatus(char* statusBuffer, int bufferSize)
         return;
     }
     
-    snprintf(statusBuffer, bufferSize, "LOCK: ON %.1f°/%.1f°", gLockedPan, gLockedTilt);
+    if (gLockMode == LOCK_MODE_GEO) {
+        snprintf(statusBuffer, bufferSize, "LOCK: GEO %.4f %.4f", gLockLatitude, gLockLongitude);
+    } else {
+        snprintf(statusBuffer, bufferSize, "LOCK: ON %.1f°/%.1f°", gLockedPan, gLockedTilt);
+    }
     statusBuffer[bufferSize - 1] = '\0';
 }
@@ -27,12 +27,24 @@
 #ifndef FLIR_SIMPLELOCK_H
 #define FLIR_SIMPLELOCK_H
 
+// Direction locks hold pan/tilt against the airframe, geo locks hold a
+// terrain point under the reticle
+enum {
+    LOCK_MODE_DIRECTION = 0,
+    LOCK_MODE_GEO = 1
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 void InitializeSimpleLock();
 void LockCurrentDirection(float currentPan, float currentTilt);
+
+// Casts the boresight against terrain; returns 0 if nothing was hit in range
+int LockBoresightPoint();
+int GetLockedWorldPoint(double* outLatitude, double* outLongitude, double* outAltitude);
+int GetSimpleLockMode();
 void GetLockedAngles(float* outPan, float* outTilt);
 void DisableSimpleLock();
 int IsSimpleLockActive();
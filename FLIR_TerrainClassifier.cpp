@@ -0,0 +1,275 @@
+/*
+ * Background terrain classifier probing the camera footprint for water and caching results per lat/lon cell
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "XPLMDataAccess.h"
+#include "XPLMGraphics.h"
+#include "XPLMProcessing.h"
+#include "XPLMScenery.h"
+#include "XPLMUtilities.h"
+#include "FLIR_Camera.h"
+#include "FLIR_TerrainClassifier.h"
+
+#define TILE_CACHE_SIZE 1024
+#define TILE_HASH_SIZE 2048
+#define TILE_NONE -1
+
+// One cached probe result per lat/lon cell
+typedef struct {
+    int latCell;
+    int lonCell;
+    int next;               // Hash chain
+    unsigned int lastUsed;  // LRU stamp
+    unsigned char terrain;
+} TerrainTile;
+
+static TerrainTile gTiles[TILE_CACHE_SIZE];
+static int gTileHash[TILE_HASH_SIZE];
+static int gTileCount = 0;
+static unsigned int gStamp = 0;
+
+static XPLMFlightLoopID gClassifierLoop = NULL;
+static XPLMProbeRef gProbe = NULL;
+static float gUpdateInterval = 0.1f;
+static int gProbesPerUpdate = 12;        // Probe budget per update, the rest waits
+static float gCellDegrees = 0.002f;      // ~200 m cells
+static float gMaxRange = 20000.0f;
+
+static unsigned char gMask[FLIR_TERRAIN_MASK_WIDTH * FLIR_TERRAIN_MASK_HEIGHT];
+static int gNextCell = 0;                // Round-robin start so every cell gets probed
+static int gProbeCount = 0;
+static int gLookups = 0;
+static int gHits = 0;
+
+static unsigned int HashCell(int latCell, int lonCell)
+{
+    return ((unsigned int)latCell * 73856093u) ^ ((unsigned int)lonCell * 19349663u);
+}
+
+static int FindTile(int latCell, int lonCell)
+{
+    int index = gTileHash[HashCell(latCell, lonCell) % TILE_HASH_SIZE];
+    while (index != TILE_NONE) {
+        if (gTiles[index].latCell == latCell && gTiles[index].lonCell == lonCell) {
+            return index;
+        }
+        index = gTiles[index].next;
+    }
+    return TILE_NONE;
+}
+
+static void UnlinkTile(int index)
+{
+    int* link = &gTileHash[HashCell(gTiles[index].latCell, gTiles[index].lonCell) % TILE_HASH_SIZE];
+    while (*link != TILE_NONE) {
+        if (*link == index) {
+            *link = gTiles[index].next;
+            return;
+        }
+        link = &gTiles[*link].next;
+    }
+}
+
+static void InsertTile(int latCell, int lonCell, unsigned char terrain)
+{
+    int index;
+    if (gTileCount < TILE_CACHE_SIZE) {
+        index = gTileCount++;
+    } else {
+        // Evict the least recently used cell
+        index = 0;
+        for (int i = 1; i < TILE_CACHE_SIZE; i++) {
+            if (gTiles[i].lastUsed < gTiles[index].lastUsed) index = i;
+        }
+        UnlinkTile(index);
+    }
+
+    unsigned int bucket = HashCell(latCell, lonCell) % TILE_HASH_SIZE;
+    gTiles[index].latCell = latCell;
+    gTiles[index].lonCell = lonCell;
+    gTiles[index].terrain = terrain;
+    gTiles[index].lastUsed = gStamp;
+    gTiles[index].next = gTileHash[bucket];
+    gTileHash[bucket] = index;
+}
+
+static void ResetTileCache()
+{
+    for (int i = 0; i < TILE_HASH_SIZE; i++) gTileHash[i] = TILE_NONE;
+    gTileCount = 0;
+    memset(gMask, FLIR_TERRAIN_UNKNOWN, sizeof(gMask));
+}
+
+static float ClassifierLoopCallback(float inElapsedSinceLastCall, float inElapsedTimeSinceLastFlightLoop,
+                                    int inCounter, void* inRefcon)
+{
+    FLIRCameraView view;
+    GetFLIRCameraView(&view);
+    if (!view.valid || !gProbe) {
+        memset(gMask, FLIR_TERRAIN_UNKNOWN, sizeof(gMask));
+        return 1.0f;
+    }
+
+    gStamp++;
+
+    XPLMProbeInfo_t info;
+    info.structSize = sizeof(info);
+
+    // Reference ground height under the camera for the footprint plane
+    if (XPLMProbeTerrainXYZ(gProbe, view.x, view.y, view.z, &info) != xplm_ProbeHitTerrain) {
+        return gUpdateInterval;
+    }
+    float groundY = info.locationY;
+    gProbeCount++;
+
+    // Cell keys come from a local linearisation around the camera, one
+    // XPLMLocalToWorld per update instead of one per cell
+    double camLat, camLon, camAlt;
+    XPLMLocalToWorld(view.x, view.y, view.z, &camLat, &camLon, &camAlt);
+    double metersPerDegLat = 111320.0;
+    double metersPerDegLon = 111320.0 * cos(camLat * M_PI / 180.0);
+
+    // Line-of-sight basis from the mount transform (+X east, +Y up, -Z north)
+    float fx = view.forward[0], fy = view.forward[1], fz = view.forward[2];
+    float rrx = view.right[0], rry = view.right[1], rrz = view.right[2];
+    float urx = view.up[0], ury = view.up[1], urz = view.up[2];
+
+    float tanH = tanf(view.fovHorizontal * 0.5f * M_PI / 180.0f);
+    float tanV = tanf(view.fovVertical * 0.5f * M_PI / 180.0f);
+
+    int cellCount = FLIR_TERRAIN_MASK_WIDTH * FLIR_TERRAIN_MASK_HEIGHT;
+    int probesLeft = gProbesPerUpdate;
+    int resumeCell = -1;
+
+    for (int n = 0; n < cellCount; n++) {
+        int cell = (gNextCell + n) % cellCount;
+        int cx = cell % FLIR_TERRAIN_MASK_WIDTH;
+        int cy = cell / FLIR_TERRAIN_MASK_WIDTH;
+        float u = ((cx + 0.5f) / FLIR_TERRAIN_MASK_WIDTH * 2.0f - 1.0f) * tanH;
+        float v = ((cy + 0.5f) / FLIR_TERRAIN_MASK_HEIGHT * 2.0f - 1.0f) * tanV;
+
+        float dx = fx + rrx * u + urx * v;
+        float dy = fy + rry * u + ury * v;
+        float dz = fz + rrz * u + urz * v;
+
+        // Rays above the horizon or beyond useful range stay unknown
+        float t = dy < -1.0e-4f ? (groundY - view.y) / dy : -1.0f;
+        if (t <= 0.0f || t * sqrtf(dx * dx + dy * dy + dz * dz) > gMaxRange) {
+            gMask[cell] = FLIR_TERRAIN_UNKNOWN;
+            continue;
+        }
+
+        float px = view.x + dx * t;
+        float pz = view.z + dz * t;
+        double lat = camLat - (pz - view.z) / metersPerDegLat;
+        double lon = camLon + (px - view.x) / metersPerDegLon;
+        int latCell = (int)floor(lat / gCellDegrees);
+        int lonCell = (int)floor(lon / gCellDegrees);
+
+        gLookups++;
+        int tile = FindTile(latCell, lonCell);
+        if (tile != TILE_NONE) {
+            gHits++;
+            gTiles[tile].lastUsed = gStamp;
+            gMask[cell] = gTiles[tile].terrain;
+            continue;
+        }
+
+        // Out of budget: keep the last known class until a later update probes it
+        if (probesLeft <= 0) {
+            if (resumeCell < 0) resumeCell = cell;
+            continue;
+        }
+
+        probesLeft--;
+        gProbeCount++;
+        unsigned char terrain = FLIR_TERRAIN_UNKNOWN;
+        if (XPLMProbeTerrainXYZ(gProbe, px, groundY, pz, &info) == xplm_ProbeHitTerrain) {
+            terrain = info.is_wet ? FLIR_TERRAIN_WATER : FLIR_TERRAIN_LAND;
+            InsertTile(latCell, lonCell, terrain);
+        }
+        gMask[cell] = terrain;
+    }
+
+    if (resumeCell >= 0) gNextCell = resumeCell;
+    return gUpdateInterval;
+}
+
+void InitializeTerrainClassifier()
+{
+    ResetTileCache();
+    gProbe = XPLMCreateProbe(xplm_ProbeY);
+
+    XPLMCreateFlightLoop_t params;
+    params.structSize = sizeof(params);
+    params.phase = xplm_FlightLoop_Phase_AfterFlightModel;
+    params.callbackFunc = ClassifierLoopCallback;
+    params.refcon = NULL;
+
+    gClassifierLoop = XPLMCreateFlightLoop(&params);
+}
+
+void CleanupTerrainClassifier()
+{
+    if (gClassifierLoop) {
+        XPLMDestroyFlightLoop(gClassifierLoop);
+        gClassifierLoop = NULL;
+    }
+    if (gProbe) {
+        XPLMDestroyProbe(gProbe);
+        gProbe = NULL;
+    }
+    ResetTileCache();
+}
+
+void SetTerrainClassifierActive(int active)
+{
+    if (!gClassifierLoop) return;
+    XPLMScheduleFlightLoop(gClassifierLoop, active ? -1.0f : 0.0f, 1);
+    if (!active) {
+        memset(gMask, FLIR_TERRAIN_UNKNOWN, sizeof(gMask));
+    }
+}
+
+const unsigned char* GetTerrainClassMask()
+{
+    return gMask;
+}
+
+void GetTerrainClassifierStatus(char* statusBuffer, int bufferSize)
+{
+    int hitRate = gLookups > 0 ? (int)((gHits * 100LL) / gLookups) : 0;
+    snprintf(statusBuffer, bufferSize, "TERR: TILES %d PROBES %d HIT %d%%", gTileCount, gProbeCount, hitRate);
+    statusBuffer[bufferSize - 1] = '\0';
+}
@@ -0,0 +1,53 @@
+/*
+ * Header file for the terrain-probe water classifier
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLIR_TERRAINCLASSIFIER_H
+#define FLIR_TERRAINCLASSIFIER_H
+
+// Screen-space class mask, row 0 is the bottom of the screen like glReadPixels
+#define FLIR_TERRAIN_MASK_WIDTH 32
+#define FLIR_TERRAIN_MASK_HEIGHT 18
+
+#define FLIR_TERRAIN_UNKNOWN 0
+#define FLIR_TERRAIN_LAND 1
+#define FLIR_TERRAIN_WATER 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void InitializeTerrainClassifier();
+void CleanupTerrainClassifier();
+// Probing only runs while active; the mask reads unknown otherwise
+void SetTerrainClassifierActive(int active);
+const unsigned char* GetTerrainClassMask();
+void GetTerrainClassifierStatus(char* statusBuffer, int bufferSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLIR_TERRAINCLASSIFIER_H
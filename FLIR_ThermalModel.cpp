@@ -0,0 +1,147 @@
+/*
+ * Time-of-day thermal model computing apparent material temperatures from sim time and sun elevation, including dawn/dusk contrast crossover
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "XPLMProcessing.h"
+#include "XPLMUtilities.h"
+#include "FLIR_ThermalModel.h"
+#include "FLIR_VisualEffects.h"
+#include "FLIR_SimState.h"
+
+// Per-material response, temperatures in degrees C relative to air
+typedef struct {
+    float offset;       // Constant bias
+    float diurnal;      // Amplitude of the lagged day/night swing
+    float solar;        // Direct heating at full sun
+} MaterialResponse;
+
+static const MaterialResponse gMaterials[FLIR_MATERIAL_COUNT] = {
+    {  0.0f, 5.0f,  6.0f }, // Neutral: generic soil and structures
+    { -35.0f, 0.0f, 5.0f }, // Sky: cold sky radiance, slightly warmer by day
+    {  0.0f, 3.0f,  2.0f }, // Vegetation: transpiration keeps it near air temperature
+    {  0.0f, 8.0f, 12.0f }, // Concrete: strong solar gain, cools hard at night
+    { 40.0f, 0.0f,  0.0f }, // Hot: engines and exhausts
+    { -3.0f, 2.0f,  0.0f }, // Shadow: no insolation
+    {  2.0f, 1.0f,  0.5f }  // Water: huge thermal inertia, warmer than land at night
+};
+
+static XPLMFlightLoopID gThermalLoop = NULL;
+static float gUpdateInterval = 3.0f;
+static float gGrayPerDegree = 1.25f;
+static int gChangeThreshold = 2; // Gray levels before the table is regenerated
+
+static float gSunElevation = 0.0f;
+static float gTemperatures[FLIR_MATERIAL_COUNT];
+static int gHeatTable[FLIR_MATERIAL_COUNT];
+static int gTableGeneration = 0;
+
+static void ComputeTemperatures(float localTimeSec, float sunElevationDeg)
+{
+    // Direct insolation follows the sun, surface temperature lags it with a
+    // peak around 14:00 local and a minimum just before dawn
+    float solar = fmaxf(0.0f, sinf(sunElevationDeg * M_PI / 180.0f));
+    float lagged = cosf(2.0f * M_PI * (localTimeSec - 14.0f * 3600.0f) / 86400.0f);
+
+    for (int i = 0; i < FLIR_MATERIAL_COUNT; i++) {
+        gTemperatures[i] = gMaterials[i].offset + gMaterials[i].diurnal * lagged + gMaterials[i].solar * solar;
+    }
+}
+
+static float ThermalLoopCallback(float inElapsedSinceLastCall, float inElapsedTimeSinceLastFlightLoop,
+                                 int inCounter, void* inRefcon)
+{
+    const FLIRSimState* state = GetSimState();
+    if (!state->valid) {
+        return 1.0f;
+    }
+
+    gSunElevation = state->sunPitch;
+    ComputeTemperatures(state->localTime, gSunElevation);
+
+    // Contrast is relative to the generic background so overall brightness stays put
+    float reference = gTemperatures[FLIR_MATERIAL_NEUTRAL];
+    int table[FLIR_MATERIAL_COUNT];
+    int changed = 0;
+
+    for (int i = 0; i < FLIR_MATERIAL_COUNT; i++) {
+        table[i] = (int)lroundf((gTemperatures[i] - reference) * gGrayPerDegree);
+        if (abs(table[i] - gHeatTable[i]) >= gChangeThreshold) {
+            changed = 1;
+        }
+    }
+
+    if (changed || gTableGeneration == 0) {
+        memcpy(gHeatTable, table, sizeof(gHeatTable));
+        SetMaterialHeatTable(gHeatTable);
+        gTableGeneration++;
+    }
+
+    return gUpdateInterval;
+}
+
+void InitializeThermalModel()
+{
+    gTableGeneration = 0;
+
+    XPLMCreateFlightLoop_t params;
+    params.structSize = sizeof(params);
+    params.phase = xplm_FlightLoop_Phase_AfterFlightModel;
+    params.callbackFunc = ThermalLoopCallback;
+    params.refcon = NULL;
+
+    gThermalLoop = XPLMCreateFlightLoop(&params);
+}
+
+void CleanupThermalModel()
+{
+    if (gThermalLoop) {
+        XPLMDestroyFlightLoop(gThermalLoop);
+        gThermalLoop = NULL;
+    }
+}
+
+void SetThermalModelActive(int active)
+{
+    if (gThermalLoop) {
+        XPLMScheduleFlightLoop(gThermalLoop, active ? -1.0f : 0.0f, 1);
+    }
+}
+
+void GetThermalModelStatus(char* statusBuffer, int bufferSize)
+{
+    snprintf(statusBuffer, bufferSize, "THM: SUN %.0f CONC %+d VEG %+d H2O %+d GEN %d",
+             gSunElevation, gHeatTable[FLIR_MATERIAL_CONCRETE], gHeatTable[FLIR_MATERIAL_VEGETATION],
+             gHeatTable[FLIR_MATERIAL_WATER], gTableGeneration);
+    statusBuffer[bufferSize - 1] = '\0';
+}
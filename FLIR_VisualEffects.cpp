@@ -39,9 +39,19 @@
 #include "XPLMDataAccess.h"
 #include "XPLMUtilities.h"
 #include "FLIR_VisualEffects.h"
+#include "FLIR_GLExt.h"
+#include "FLIR_Camera.h"
+#include "FLIR_TerrainClassifier.h"
+#include "FLIR_PostShader.h"
+#include "FLIR_HybridShader.h"
+#include "FLIR_FrameUpload.h"
+#include "FLIR_OverlayGL.h"
+#include "FLIR_OverlayContent.h"
+#include "FLIR_OverlayRaster.h"
 
 #include <windows.h>
 #include <GL/gl.h>
+#include "FLIR_GLStats.h"
 
 static int gMonochromeEnabled = 0;
 static int gThermalEnabled = 1;
@@ -61,19 +71,189 @@ static int gBufferHeight = 0;
 static int gProcessingCounter = 0;
 static int gProcessingSkip = 5; // Process every 6th frame for caching
 static float gProcessingScale = 0.25f; // Process at quarter resolution
-static int gUseHybridMode = 1; // Use hybrid shader+overlay approach
+static int gRenderer = FLIR_RENDERER_POST_SHADER;
+static XPLMDataRef gRendererRef = NULL;
+static int gPostProcessingActive = 0;
+
+// Depth readback for range-aware processing
+static int gDepthReadbackEnabled = 1;
+static GLuint gDepthPBO[2] = {0, 0};
+static int gDepthPBOPending[2] = {0, 0};
+static float gDepthProjection[2][3]; // P[10], P[11], P[14] at capture time
+static int gDepthPBOIndex = 0;
+static int gDepthWidth = 0;
+static int gDepthHeight = 0;
+static const int gRangeShift = 2; // Range grid at quarter resolution
+static unsigned char* gRangeBuckets = NULL;
+static int gRangeWidth = 0;
+static int gRangeHeight = 0;
+static int gRangeValid = 0;
+static unsigned short gAttenuation[FLIR_RANGE_BUCKETS]; // 8.8 fixed point contrast transmission
+static const int gPathLevel = 110; // Gray level distant objects fade towards
+static int gAttenuationVersion = 0;
+static int gRangeVersion = 0;
+
+// Heat offset per material class, regenerated by the thermal model
+static int gMaterialHeat[FLIR_MATERIAL_COUNT] = {
+    0,   // Neutral
+    -30, // Sky is cold
+    -15, // Vegetation is cooler
+    10,  // Ground/concrete slightly warm
+    25,  // Bright objects assumed warm
+    -20, // Deep shadows are cold
+    -10  // Water lags behind the land
+};
+static XPLMDataRef gProjectionMatrixRef = NULL;
+static XPLMDataRef gReverseZRef = NULL;
+
+// Horizon segmentation projected from the camera attitude
+#define FLIR_MAX_ROWS 4096
+#define HORIZON_GROUND 0
+#define HORIZON_SKY 1
+#define HORIZON_MIXED 2
+static int gHorizonValid = 0;
+static int gHorizonWidth = 0;
+static int gHorizonHeight = 0;
+static unsigned char gHorizonRowClass[FLIR_MAX_ROWS];
+static float gHorizonRowStart[FLIR_MAX_ROWS]; // Signed sky distance at x = 0, > 0 is sky
+static float gHorizonStep = 0.0f;              // Change of the sky distance per pixel along a row
+static float gHorizonPlane[3];                 // Same distance as a plane over window coordinates
+
+// Transfer curves for modes 1-3, see FLIR_TRANSFER_SIZE
+static unsigned char gTransfer[3][FLIR_TRANSFER_SIZE][3];
+
+// Overlay textures for the camera noise frames and repeating patterns
+static int gNoiseTextures[OVERLAY_NOISE_FRAMES];
+static int gNoiseTexturesReady = 0;
+static float gNoiseTextureIntensity = -1.0f;
+static int gPatternTextures[OVERLAY_PATTERN_COUNT];
+static const float gPatternColors[OVERLAY_PATTERN_COUNT][3] = {
+    { 0.0f, 0.0f, 0.0f },
+    { 1.0f, 1.0f, 1.0f },
+    { 1.0f, 1.0f, 1.0f }
+};
+#define GRID_16_OPACITY 0.06f   // Grid texels are half coverage, so double the alpha
+#define GRID_8_OPACITY 0.2f
+static int gPatternTexturesReady = 0;
+static OverlayGeometry gPatternGeometry[OVERLAY_PATTERN_COUNT];
+
+// Retained full-screen passes for the hybrid modes, rebuilt on resolution change
+static OverlayGeometry gHybridGeometry[4];
+
+// Hybrid mode passes folded into one transfer table for the single-pass shader
+static unsigned char gHybridTransfer[HYBRID_TRANSFER_ROWS * HYBRID_TRANSFER_LEVELS * 4];
+static OverlayGeometry gHybridTransferGeometry;
+static int gHybridTransferMode = 0;
+static int gHybridTransferVersion = 0;
+static int gHybridShaderEnabled = 1;
+
+// Fallback filter passes (mono, thermal, IR), also keyed on the enhancement settings
+static OverlayGeometry gFilterGeometry[3];
+static int gEnhancementVersion = 0;
+
+// Noise quad and glitch lines, rebuilt whenever the noise frame changes
+static OverlayGeometry gNoiseGeometry;
+
+// Terrain class mask lookup, mask column for every pixel column
+static unsigned char gTerrainColumn[4096];
+static int gTerrainColumnWidth = 0;
 
 // Forward declarations
 void ProcessEOIROptimized(unsigned char* input, unsigned char* output, int width, int height, int mode);
 void RenderHybridEffects(int screenWidth, int screenHeight, int mode);
+static void ReleaseDepthReadback();
+static void SubmitPattern(int pattern, int layer, float opacity);
+static int RenderHybridLookup(int screenWidth, int screenHeight, int mode);
+
+// Tabulate the per-mode gray mapping once; the CPU kernel and the shader
+// both look results up here, so the two paths cannot drift apart
+static void BuildTransferTables()
+{
+    for (int mode = 1; mode <= 3; mode++) {
+        for (int i = 0; i < FLIR_TRANSFER_SIZE; i++) {
+            int gray = i - FLIR_TRANSFER_OFFSET;
+            unsigned char* out = gTransfer[mode - 1][i];
+            
+            switch (mode) {
+                case 1: // Monochrome - enhanced but not too harsh
+                    gray = (gray * 5) >> 2; // *1.25 instead of *1.5
+                    if (gray < 0) gray = 20; // Don't go pure black
+                    if (gray > 255) gray = 255;
+                    
+                    // Green tint for night vision
+                    out[0] = (unsigned char)((gray * 180) >> 8);     // R * 0.7
+                    out[1] = (unsigned char)gray;                    // G
+                    out[2] = (unsigned char)((gray * 180) >> 8);     // B * 0.7
+                    break;
+                    
+                case 2: // Thermal - with heat signatures
+                    if (gray < 0) gray = 30; // Minimum visible level
+                    if (gray > 255) gray = 255;
+                    
+                    // Don't fully invert - partial inversion looks more realistic
+                    gray = 200 - (gray * 3 >> 2); // Partial invert and enhance
+                    if (gray < 40) gray = 40; // Keep some visibility
+                    if (gray > 255) gray = 255;
+                    
+                    out[0] = out[1] = out[2] = (unsigned char)gray;
+                    break;
+                    
+                case 3: // Enhanced IR - high contrast but not crushing
+                    if (gray < 0) gray = 25;
+                    if (gray > 255) gray = 255;
+                    
+                    // Less harsh threshold
+                    if (gray > 140) gray = 240;
+                    else if (gray > 80) gray = 160;
+                    else if (gray > 40) gray = 80;
+                    else gray = 30; // Minimum visibility
+                    
+                    out[0] = out[1] = out[2] = (unsigned char)gray;
+                    break;
+            }
+        }
+    }
+}
+
+static int GetRendererCallback(void* inRefcon)
+{
+    return gRenderer;
+}
+
+static void SetRendererCallback(void* inRefcon, int inValue)
+{
+    SetVisualRenderer(inValue);
+}
 
 void InitializeVisualEffects()
 {
     srand(time(NULL));
+    
+    // 0 GLSL post-processing (default), 1 CPU post-processing, 2 hybrid overlays
+    gRendererRef = XPLMRegisterDataAccessor("flir/effects/renderer", xplmType_Int, 1,
+                                            GetRendererCallback, SetRendererCallback,
+                                            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                            NULL, NULL);
+
+    gProjectionMatrixRef = XPLMFindDataRef("sim/graphics/view/projection_matrix_3d");
+    gReverseZRef = XPLMFindDataRef("sim/graphics/view/is_reverse_float_z");
+
+    // Clear-air default (~23 km visibility) until a weather model provides a table
+    float extinction = 3.912f / 23000.0f;
+    for (int i = 0; i < FLIR_RANGE_BUCKETS; i++) {
+        gAttenuation[i] = (unsigned short)(expf(-extinction * BucketToRange(i)) * 256.0f);
+    }
+    gAttenuation[FLIR_RANGE_SKY_BUCKET] = 256;
+    
+    BuildTransferTables();
 }
 
 void CleanupVisualEffects()
 {
+    if (gRendererRef) {
+        XPLMUnregisterDataAccessor(gRendererRef);
+        gRendererRef = NULL;
+    }
     if (gPixelBuffer) {
         free(gPixelBuffer);
         gPixelBuffer = NULL;
@@ -82,6 +262,28 @@ void CleanupVisualEffects()
         free(gProcessedBuffer);
         gProcessedBuffer = NULL;
     }
+    ReleaseDepthReadback();
+    ReleasePostShader();
+    ReleaseHybridShader();
+    ReleaseFrameUpload();
+    // The texels themselves belong to the overlay layer, see ReleaseOverlayResources
+    memset(gNoiseTextures, 0, sizeof(gNoiseTextures));
+    memset(gPatternTextures, 0, sizeof(gPatternTextures));
+    gNoiseTexturesReady = 0;
+    gNoiseTextureIntensity = -1.0f;
+    gPatternTexturesReady = 0;
+    for (int i = 0; i < 4; i++) {
+        ReleaseOverlayGeometry(&gHybridGeometry[i]);
+    }
+    ReleaseOverlayGeometry(&gHybridTransferGeometry);
+    gHybridTransferMode = 0;
+    for (int i = 0; i < 3; i++) {
+        ReleaseOverlayGeometry(&gFilterGeometry[i]);
+    }
+    for (int i = 0; i < OVERLAY_PATTERN_COUNT; i++) {
+        ReleaseOverlayGeometry(&gPatternGeometry[i]);
+    }
+    ReleaseOverlayGeometry(&gNoiseGeometry);
 }
 
 // Safety function to allocate pixel buffers
@@ -113,6 +315,227 @@ int AllocatePixelBuffer(int width, int height)
     return 1; // Success
 }
 
+int RangeToBucket(float rangeMeters)
+{
+    if (rangeMeters <= 0.0f) return 0;
+    int bucket = (int)(sqrtf(rangeMeters / FLIR_RANGE_MAX_METERS) * (FLIR_RANGE_SKY_BUCKET - 1));
+    return bucket < FLIR_RANGE_SKY_BUCKET - 1 ? bucket : FLIR_RANGE_SKY_BUCKET - 1;
+}
+
+float BucketToRange(int bucket)
+{
+    float t = (float)bucket / (FLIR_RANGE_SKY_BUCKET - 1);
+    return t * t * FLIR_RANGE_MAX_METERS;
+}
+
+void SetDepthReadback(int enabled)
+{
+    gDepthReadbackEnabled = enabled;
+    if (!enabled) {
+        gRangeValid = 0;
+    }
+}
+
+// Contrast transmission per range bucket, 8.8 fixed point
+void SetAttenuationTable(const unsigned short* table)
+{
+    memcpy(gAttenuation, table, sizeof(gAttenuation));
+    gAttenuationVersion++;
+}
+
+void SetMaterialHeatTable(const int* table)
+{
+    memcpy(gMaterialHeat, table, sizeof(gMaterialHeat));
+}
+
+static void ReleaseDepthReadback()
+{
+    if (gDepthPBO[0] && flirDeleteBuffers) {
+        flirDeleteBuffers(2, gDepthPBO);
+    }
+    gDepthPBO[0] = gDepthPBO[1] = 0;
+    gDepthPBOPending[0] = gDepthPBOPending[1] = 0;
+    gDepthWidth = gDepthHeight = 0;
+
+    if (gRangeBuckets) {
+        free(gRangeBuckets);
+        gRangeBuckets = NULL;
+    }
+    gRangeWidth = gRangeHeight = 0;
+    gRangeValid = 0;
+}
+
+// Decimate a mapped depth readback into the quarter resolution range grid
+static void BuildRangeGrid(const float* depth, const float* projection)
+{
+    int reverseZ = gReverseZRef ? XPLMGetDatai(gReverseZRef) : 0;
+    float m10 = projection[0];
+    float m11 = projection[1];
+    float m14 = projection[2];
+    int cell = 1 << gRangeShift;
+    int skyCells = 0;
+
+    for (int gy = 0; gy < gRangeHeight; gy++) {
+        int y = gy * cell + cell / 2;
+        if (y >= gDepthHeight) y = gDepthHeight - 1;
+        const float* depthRow = depth + y * gDepthWidth;
+        unsigned char* bucketRow = gRangeBuckets + gy * gRangeWidth;
+
+        for (int gx = 0; gx < gRangeWidth; gx++) {
+            int x = gx * cell + cell / 2;
+            if (x >= gDepthWidth) x = gDepthWidth - 1;
+            float d = depthRow[x];
+
+            // Far plane hits are sky, no surface to attenuate
+            if (reverseZ ? (d <= 0.0f) : (d >= 0.999999f)) {
+                bucketRow[gx] = FLIR_RANGE_SKY_BUCKET;
+                skyCells++;
+                continue;
+            }
+
+            // Invert the projection's z row: z_view = P14 / (ndc * P11 - P10)
+            float ndc = reverseZ ? d : d * 2.0f - 1.0f;
+            float denom = ndc * m11 - m10;
+            float range = denom != 0.0f ? -m14 / denom : FLIR_RANGE_MAX_METERS;
+            bucketRow[gx] = (unsigned char)RangeToBucket(range);
+        }
+    }
+
+    // A depth buffer that is entirely far plane was most likely cleared before
+    // our draw phase; fall back to the colour heuristics rather than trust it
+    gRangeValid = skyCells < (gRangeWidth * gRangeHeight * 98) / 100;
+    gRangeVersion++;
+}
+
+// Asynchronous depth readback through a pair of pixel pack buffers. The read
+// issued this frame is consumed on the next processed frame, so the CPU never
+// waits on the GPU.
+static void UpdateRangeBuffer(int width, int height)
+{
+    InitializeGLExtensions();
+    if (!HasBufferObjects() || !gProjectionMatrixRef) {
+        gDepthReadbackEnabled = 0;
+        gRangeValid = 0;
+        return;
+    }
+
+    if (!gDepthPBO[0]) {
+        flirGenBuffers(2, gDepthPBO);
+    }
+
+    if (gDepthWidth != width || gDepthHeight != height) {
+        for (int i = 0; i < 2; i++) {
+            flirBindBuffer(GL_PIXEL_PACK_BUFFER, gDepthPBO[i]);
+            flirBufferData(GL_PIXEL_PACK_BUFFER, (FLIRGLsizeiptr)width * height * sizeof(float), NULL, GL_STREAM_READ);
+            gDepthPBOPending[i] = 0;
+        }
+
+        if (gRangeBuckets) free(gRangeBuckets);
+        gRangeWidth = (width + (1 << gRangeShift) - 1) >> gRangeShift;
+        gRangeHeight = (height + (1 << gRangeShift) - 1) >> gRangeShift;
+        gRangeBuckets = (unsigned char*)malloc(gRangeWidth * gRangeHeight);
+        gRangeValid = 0;
+        gDepthWidth = width;
+        gDepthHeight = height;
+
+        if (!gRangeBuckets) {
+            flirBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            ReleaseDepthReadback();
+            gDepthReadbackEnabled = 0;
+            return;
+        }
+    }
+
+    int current = gDepthPBOIndex;
+    int previous = current ^ 1;
+
+    // Kick off this frame's read with the projection it was rendered with
+    float projection[16];
+    XPLMGetDatavf(gProjectionMatrixRef, projection, 0, 16);
+    gDepthProjection[current][0] = projection[10];
+    gDepthProjection[current][1] = projection[11];
+    gDepthProjection[current][2] = projection[14];
+
+    while (glGetError() != GL_NO_ERROR) { }
+    flirBindBuffer(GL_PIXEL_PACK_BUFFER, gDepthPBO[current]);
+    glReadPixels(0, 0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, 0);
+    gDepthPBOPending[current] = glGetError() == GL_NO_ERROR;
+
+    // Consume the read issued on the previous processed frame
+    if (gDepthPBOPending[previous]) {
+        flirBindBuffer(GL_PIXEL_PACK_BUFFER, gDepthPBO[previous]);
+        const float* depth = (const float*)flirMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+        if (depth) {
+            BuildRangeGrid(depth, gDepthProjection[previous]);
+            flirUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        gDepthPBOPending[previous] = 0;
+    }
+
+    flirBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    gDepthPBOIndex = previous;
+
+    if (!gDepthPBOPending[current]) {
+        // Depth reads unsupported in this context, stay on colour heuristics
+        while (glGetError() != GL_NO_ERROR) { }
+        ReleaseDepthReadback();
+        gDepthReadbackEnabled = 0;
+    }
+}
+
+// Project the horizon line for the current camera attitude into a plane over
+// window coordinates and, for the CPU kernel, per-row sky/ground classes.
+// Rows come from glReadPixels, so row 0 is the bottom.
+static void UpdateHorizonMask(int width, int height, int rowClasses)
+{
+    FLIRCameraView view;
+    GetFLIRCameraView(&view);
+    
+    if (!view.valid || height > FLIR_MAX_ROWS || view.fovVertical <= 0.0f) {
+        gHorizonValid = 0;
+        return;
+    }
+    
+    float focal = (height * 0.5f) / tanf(view.fovVertical * 0.5f * M_PI / 180.0f);
+    
+    // The visible horizon dips below the horizontal with altitude
+    float dip = view.elevation > 0.0f ? sqrtf(2.0f * view.elevation / 6371000.0f) : 0.0f;
+    float pitch = view.pitch * M_PI / 180.0f + dip;
+    float limit = 89.9f * M_PI / 180.0f;
+    if (pitch > limit) pitch = limit;
+    if (pitch < -limit) pitch = -limit;
+    
+    float roll = view.roll * M_PI / 180.0f;
+    float sinRoll = sinf(roll);
+    float cosRoll = cosf(roll);
+    float offset = focal * tanf(pitch);
+    float halfWidth = width * 0.5f;
+    float halfHeight = height * 0.5f;
+    
+    // Un-rolled image height of a pixel relative to the horizon line:
+    // s = -u * sin(roll) + v * cos(roll) + f * tan(pitch), sky where s > 0
+    gHorizonStep = -sinRoll;
+    gHorizonPlane[0] = halfWidth * sinRoll - halfHeight * cosRoll + offset;
+    gHorizonPlane[1] = -sinRoll;
+    gHorizonPlane[2] = cosRoll;
+    
+    // The shader evaluates the plane per fragment and never reads the rows
+    for (int y = 0; rowClasses && y < height; y++) {
+        float v = y + 0.5f - halfHeight;
+        float start = (0.5f - halfWidth) * -sinRoll + v * cosRoll + offset;
+        float end = start + (width - 1) * gHorizonStep;
+        
+        gHorizonRowStart[y] = start;
+        if (start > 0.0f && end > 0.0f) gHorizonRowClass[y] = HORIZON_SKY;
+        else if (start <= 0.0f && end <= 0.0f) gHorizonRowClass[y] = HORIZON_GROUND;
+        else gHorizonRowClass[y] = HORIZON_MIXED;
+    }
+    
+    gHorizonWidth = width;
+    gHorizonHeight = height;
+    gHorizonValid = 1;
+}
+
 // Convert RGB to grayscale with EO/IR processing
 void ProcessEOIR(unsigned char* pixels, int width, int height, int mode)
 {
@@ -183,13 +606,16 @@ void ProcessEOIR(unsigned char* pixels, int width, int height, int mode)
     }
 }
 
-// Optimized post-processing function
-void RenderPostProcessing(int screenWidth, int screenHeight)
+// Optimized post-processing function. Returns 0 when nothing was drawn and the
+// caller should fall back to the hybrid overlays for this frame.
+int RenderPostProcessing(int screenWidth, int screenHeight)
 {
+    if (gRenderer == FLIR_RENDERER_HYBRID || !gPostProcessingEnabled) return 0;
+    
     // Safety check: skip if too small or too large
     if (screenWidth < 100 || screenHeight < 100 || 
         screenWidth > 4096 || screenHeight > 4096) {
-        return;
+        return 0;
     }
     
     // Skip frames for better performance
@@ -202,46 +628,142 @@ void RenderPostProcessing(int screenWidth, int screenHeight)
     else if (gThermalEnabled) processingMode = 2;
     else if (gIREnabled) processingMode = 3;
     
-    if (processingMode == 0) return; // No processing needed
+    if (processingMode == 0) return 0; // No processing needed
+    
+    // GPU path: the frame never leaves the device, so it runs every frame.
+    // Range still comes from the async depth readback on the skip cadence.
+    if (gRenderer == FLIR_RENDERER_POST_SHADER) {
+        if (shouldProcess && gDepthReadbackEnabled) {
+            UpdateRangeBuffer(screenWidth, screenHeight);
+        }
+        UpdateHorizonMask(screenWidth, screenHeight, 0);
+        
+        int useRange = gRangeValid &&
+                       gRangeWidth == ((screenWidth + (1 << gRangeShift) - 1) >> gRangeShift) &&
+                       gRangeHeight == ((screenHeight + (1 << gRangeShift) - 1) >> gRangeShift);
+        int useHorizon = gHorizonValid && gHorizonWidth == screenWidth && gHorizonHeight == screenHeight;
+        
+        PostShaderInputs inputs;
+        inputs.mode = processingMode;
+        inputs.materialHeat = gMaterialHeat;
+        inputs.pathLevel = gPathLevel;
+        inputs.attenuation = gAttenuation;
+        inputs.attenuationVersion = gAttenuationVersion;
+        inputs.transfer = &gTransfer[0][0][0];
+        inputs.transferVersion = 0;
+        inputs.rangeBuckets = useRange ? gRangeBuckets : NULL;
+        inputs.rangeWidth = gRangeWidth;
+        inputs.rangeHeight = gRangeHeight;
+        inputs.rangeCell = 1 << gRangeShift;
+        inputs.rangeVersion = gRangeVersion;
+        inputs.horizonPlane = useHorizon ? gHorizonPlane : NULL;
+        inputs.terrainMask = GetTerrainClassMask();
+        
+        if (RenderPostShader(screenWidth, screenHeight, &inputs)) {
+            return 1;
+        }
+        
+        // No GLSL, or it failed: the overlay approximations take over
+        XPLMDebugString("FLIR: GLSL post-processing unavailable, using hybrid overlay effects\n");
+        gRenderer = FLIR_RENDERER_HYBRID;
+        return 0;
+    }
     
     // Allocate buffers if needed
     if (!AllocatePixelBuffer(screenWidth, screenHeight)) {
-        return;
+        return 0;
     }
     
     // Only do expensive processing every few frames
     if (shouldProcess) {
+        if (gDepthReadbackEnabled) {
+            UpdateRangeBuffer(screenWidth, screenHeight);
+        }
+        
         // Clear any OpenGL errors
         while (glGetError() != GL_NO_ERROR) { }
         
-        // Read framebuffer
+        // Read framebuffer, tightly packed to match the buffer and the upload
+        GLint packAlignment;
+        glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
         glReadPixels(0, 0, screenWidth, screenHeight, GL_RGB, GL_UNSIGNED_BYTE, gPixelBuffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
         
         // Check for errors
         if (glGetError() != GL_NO_ERROR) {
-            return;
+            return 0;
         }
         
-        // Process with optimized function
-        ProcessEOIROptimized(gPixelBuffer, gProcessedBuffer, screenWidth, screenHeight, processingMode);
+        UpdateHorizonMask(screenWidth, screenHeight, 1);
+        
+        // The kernel writes straight into upload memory when a ring slot is free
+        unsigned char* upload = BeginFrameUpload(screenWidth, screenHeight);
+        ProcessEOIROptimized(gPixelBuffer, upload ? upload : gProcessedBuffer, screenWidth, screenHeight, processingMode);
+        if (upload) {
+            EndFrameUpload();
+        } else {
+            UploadFrame(gProcessedBuffer, screenWidth, screenHeight);
+        }
     }
     
-    // Always draw the (possibly cached) processed result
-    glRasterPos2f(0, 0);
-    glDrawPixels(screenWidth, screenHeight, GL_RGB, GL_UNSIGNED_BYTE, gProcessedBuffer);
+    // Always draw the (possibly cached) processed result, it stays resident in the texture
+    int drawn = DrawUploadedFrame(screenWidth, screenHeight);
     
     // Check for errors
     if (glGetError() != GL_NO_ERROR) {
         gPostProcessingEnabled = 0; // Disable on error
+        return 0;
+    }
+    return drawn;
+}
+
+void SetVisualRenderer(int renderer)
+{
+    if (renderer < FLIR_RENDERER_POST_SHADER || renderer > FLIR_RENDERER_HYBRID) return;
+    gRenderer = renderer;
+    gPostProcessingEnabled = 1;
+}
+
+int GetVisualRenderer()
+{
+    return gRenderer;
+}
+
+int IsPostProcessingActive()
+{
+    return gPostProcessingActive;
+}
+
+// Fake heat signature logic based on color analysis
+static inline int ClassifyMaterial(int r, int g, int b, int gray, int allowSky)
+{
+    // Sky detection (blue-ish areas are cold)
+    if (allowSky && b > r && b > g && b > 100) {
+        return FLIR_MATERIAL_SKY;
+    }
+    // Vegetation detection (green areas are cooler)  
+    if (g > r && g > b && g > 80) {
+        return FLIR_MATERIAL_VEGETATION;
+    }
+    // Ground/concrete detection (neutral colors)
+    if (abs(r - g) < 20 && abs(g - b) < 20 && gray > 60) {
+        return FLIR_MATERIAL_CONCRETE;
+    }
+    // Bright objects (could be hot engines, lights, etc)
+    if (gray > 200) {
+        return FLIR_MATERIAL_HOT;
+    }
+    // Very dark objects (shadows, cold areas)
+    if (gray < 40) {
+        return FLIR_MATERIAL_SHADOW;
     }
+    return FLIR_MATERIAL_NEUTRAL;
 }
 
 // Much faster processing function with fake heat signatures
 void ProcessEOIROptimized(unsigned char* input, unsigned char* output, int width, int height, int mode)
 {
-    int totalPixels = width * height;
-    int step = 1; // Process every pixel, but optimize the loop
-    
     // Pre-calculate noise once per frame
     static int noiseFrame = 0;
     static float frameNoise = 0.0f;
@@ -250,93 +772,88 @@ void ProcessEOIROptimized(unsigned char* input, unsigned char* output, int width
         noiseFrame = gFrameCounter;
     }
     
-    for (int i = 0; i < totalPixels; i += step) {
-        int idx = i * 3;
-        int x = i % width;
-        int y = i / width;
-        
-        // Original RGB values
-        unsigned char r = input[idx];
-        unsigned char g = input[idx + 1];
-        unsigned char b = input[idx + 2];
-        
-        // Fast integer-based grayscale conversion
-        int gray = (r * 77 + g * 151 + b * 28) >> 8; // /256
-        
-        // Fake heat signature logic based on color analysis
-        int heatBonus = 0;
-        
-        // Sky detection (blue-ish areas are cold)
-        if (b > r && b > g && b > 100) {
-            heatBonus = -30; // Sky is cold
-        }
-        // Vegetation detection (green areas are cooler)  
-        else if (g > r && g > b && g > 80) {
-            heatBonus = -15; // Vegetation is cooler
-        }
-        // Ground/concrete detection (neutral colors)
-        else if (abs(r - g) < 20 && abs(g - b) < 20 && gray > 60) {
-            heatBonus = 10; // Ground/concrete slightly warm
-        }
-        // Bright objects (could be hot engines, lights, etc)
-        else if (gray > 200) {
-            heatBonus = 25; // Bright objects assumed warm
-        }
-        // Very dark objects (shadows, cold areas)
-        else if (gray < 40) {
-            heatBonus = -20; // Deep shadows are cold
+    // Range grid must match the frame it is applied to
+    int useRange = gRangeValid &&
+                   gRangeWidth == ((width + (1 << gRangeShift) - 1) >> gRangeShift) &&
+                   gRangeHeight == ((height + (1 << gRangeShift) - 1) >> gRangeShift);
+    int useHorizon = gHorizonValid && gHorizonWidth == width && gHorizonHeight == height;
+    int skyHeat = gMaterialHeat[FLIR_MATERIAL_SKY];
+    
+    if (mode < 1 || mode > 3) {
+        memcpy(output, input, width * height * 3);
+        return;
+    }
+    const unsigned char (*transfer)[3] = gTransfer[mode - 1];
+    
+    const unsigned char* terrainMask = width <= 4096 ? GetTerrainClassMask() : NULL;
+    if (terrainMask && gTerrainColumnWidth != width) {
+        for (int x = 0; x < width; x++) {
+            gTerrainColumn[x] = (unsigned char)((x * FLIR_TERRAIN_MASK_WIDTH) / width);
         }
+        gTerrainColumnWidth = width;
+    }
+    
+    for (int y = 0; y < height; y++) {
+        int idx = y * width * 3;
+        const unsigned char* rangeRow = useRange ? gRangeBuckets + (y >> gRangeShift) * gRangeWidth : NULL;
+        const unsigned char* terrainRow = terrainMask ?
+            terrainMask + ((y * FLIR_TERRAIN_MASK_HEIGHT) / height) * FLIR_TERRAIN_MASK_WIDTH : NULL;
+        int rowClass = useHorizon ? gHorizonRowClass[y] : HORIZON_MIXED;
+        float rowSky = useHorizon ? gHorizonRowStart[y] : 0.0f;
         
-        // Ground level is warmer than sky (simple atmospheric model)
+        // Without any geometry, ground level is assumed warmer than sky (simple atmospheric model)
         float skyFactor = (float)y / height; // 0 = top, 1 = bottom
-        heatBonus += (int)(skyFactor * 15); // Ground +15, sky +0
+        int rowBonus = (int)(skyFactor * 15); // Ground +15, sky +0
         
-        // Apply heat simulation based on mode
-        switch (mode) {
-            case 1: // Monochrome - enhanced but not too harsh
-                gray += heatBonus / 2; // Subtle heat effect
-                gray = (gray * 5) >> 2; // *1.25 instead of *1.5
-                if (gray < 0) gray = 20; // Don't go pure black
-                if (gray > 255) gray = 255;
-                
-                // Green tint for night vision
-                output[idx] = (unsigned char)((gray * 180) >> 8);     // R * 0.7
-                output[idx + 1] = (unsigned char)gray;               // G
-                output[idx + 2] = (unsigned char)((gray * 180) >> 8); // B * 0.7
-                break;
-                
-            case 2: // Thermal - with heat signatures
-                gray += heatBonus; // Full heat effect
-                if (gray < 0) gray = 30; // Minimum visible level
-                if (gray > 255) gray = 255;
-                
-                // Don't fully invert - partial inversion looks more realistic
-                gray = 200 - (gray * 3 >> 2); // Partial invert and enhance
-                if (gray < 40) gray = 40; // Keep some visibility
-                if (gray > 255) gray = 255;
-                
-                output[idx] = output[idx + 1] = output[idx + 2] = (unsigned char)gray;
-                break;
-                
-            case 3: // Enhanced IR - high contrast but not crushing
-                gray += heatBonus;
-                if (gray < 0) gray = 25;
-                if (gray > 255) gray = 255;
-                
-                // Less harsh threshold
-                if (gray > 140) gray = 240;
-                else if (gray > 80) gray = 160;
-                else if (gray > 40) gray = 80;
-                else gray = 30; // Minimum visibility
-                
-                output[idx] = output[idx + 1] = output[idx + 2] = (unsigned char)gray;
-                break;
-                
-            default:
-                output[idx] = input[idx];
-                output[idx + 1] = input[idx + 1];
-                output[idx + 2] = input[idx + 2];
-                break;
+        for (int x = 0; x < width; x++, idx += 3) {
+            // Original RGB values
+            unsigned char r = input[idx];
+            unsigned char g = input[idx + 1];
+            unsigned char b = input[idx + 2];
+            
+            // Fast integer-based grayscale conversion
+            int gray = (r * 77 + g * 151 + b * 28) >> 8; // /256
+            
+            // Sky from range or the horizon line when known, -1 falls back to colour
+            int sky = -1;
+            int bucket = FLIR_RANGE_SKY_BUCKET;
+            if (rangeRow) {
+                // Sky is a single compare against the far-plane bucket
+                bucket = rangeRow[x >> gRangeShift];
+                sky = bucket == FLIR_RANGE_SKY_BUCKET;
+            } else if (useHorizon) {
+                // Rows fully above the horizon skip classification entirely,
+                // only rows crossing it need a per-pixel compare
+                sky = rowClass == HORIZON_SKY ||
+                      (rowClass == HORIZON_MIXED && rowSky + x * gHorizonStep > 0.0f);
+            }
+            
+            int heatBonus;
+            if (sky == 1) {
+                heatBonus = skyHeat;
+            } else {
+                // Probed water overrides the colour guess, blue water is not sky
+                int material = (terrainRow && terrainRow[gTerrainColumn[x]] == FLIR_TERRAIN_WATER) ?
+                    FLIR_MATERIAL_WATER : ClassifyMaterial(r, g, b, gray, sky < 0);
+                heatBonus = gMaterialHeat[material] + (sky < 0 ? rowBonus : 15);
+            }
+            
+            // Monochrome only gets a subtle heat effect
+            gray += (mode == 1) ? heatBonus / 2 : heatBonus;
+            
+            // Contrast fades towards the path radiance with range
+            if (bucket != FLIR_RANGE_SKY_BUCKET) {
+                gray = gPathLevel + (((gray - gPathLevel) * gAttenuation[bucket]) >> 8);
+            }
+            
+            // Per-mode output curve
+            int index = gray + FLIR_TRANSFER_OFFSET;
+            if (index < 0) index = 0;
+            if (index >= FLIR_TRANSFER_SIZE) index = FLIR_TRANSFER_SIZE - 1;
+            const unsigned char* mapped = transfer[index];
+            output[idx] = mapped[0];
+            output[idx + 1] = mapped[1];
+            output[idx + 2] = mapped[2];
         }
     }
 }
@@ -344,28 +861,24 @@ void ProcessEOIROptimized(unsigned char* input, unsigned char* output, int width
 // Hybrid approach: Smart overlays that mimic post-processing visually
 void RenderHybridEffects(int screenWidth, int screenHeight, int mode)
 {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, screenWidth, screenHeight, 0, -1, 1);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    
-    switch (mode) {
-        case 1: // Monochrome mode
-            RenderSmartMonochrome(screenWidth, screenHeight);
-            break;
-        case 2: // Thermal mode  
-            RenderSmartThermal(screenWidth, screenHeight);
-            break;
-        case 3: // Enhanced IR mode
-            RenderSmartIR(screenWidth, screenHeight);
-            break;
+    // One full-screen fill through the folded transfer table when GLSL is
+    // available, otherwise the mode's passes go out as overlay geometry
+    if (RenderHybridLookup(screenWidth, screenHeight, mode)) {
+        if (mode == 3) {
+            SubmitPattern(OVERLAY_PATTERN_GRID_16, OVERLAY_LAYER_FILTER, GRID_16_OPACITY);
+        }
+    } else {
+        switch (mode) {
+            case 1: // Monochrome mode
+                RenderSmartMonochrome(screenWidth, screenHeight);
+                break;
+            case 2: // Thermal mode  
+                RenderSmartThermal(screenWidth, screenHeight);
+                break;
+            case 3: // Enhanced IR mode
+                RenderSmartIR(screenWidth, screenHeight);
+                break;
+        }
     }
     
     // Add overlays
@@ -375,158 +888,174 @@ void RenderHybridEffects(int screenWidth, int screenHeight, int mode)
     if (gScanLinesEnabled) {
         RenderScanLines(screenWidth, screenHeight);
     }
-    
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
+}
+
+// Returns the geometry when its key changed and it needs rebuilding, NULL when it is current
+static OverlayGeometry* GeometryToBuild(OverlayGeometry* geometry, unsigned int key)
+{
+    if (geometry->built && geometry->key == key) {
+        return NULL;
+    }
+    ResetOverlayGeometry(geometry, key);
+    return geometry;
+}
+
+// Everything below draws from the layout the caller set up for this pass
+static unsigned int LayoutKey()
+{
+    return GetOverlayLayout()->key;
 }
 
 // Smart monochrome that mimics the post-processing look
-void RenderSmartMonochrome(int screenWidth, int screenHeight)
+static void BuildSmartMonochrome(OverlayGeometry* geometry, const OverlayLayout* layout)
 {
+    float w = layout->width;
+    float h = layout->height;
+    
     // Base desaturation with green tint
-    glBlendFunc(GL_DST_COLOR, GL_ZERO);
-    glColor4f(0.7f, 1.0f, 0.7f, 1.0f); // Green night vision tint
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
+    const float tint[4] = { 0.7f, 1.0f, 0.7f, 1.0f }; // Green night vision tint
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_MULTIPLY, 0.0f, 0);
+    AddOverlayQuad(geometry, 0, 0, w, h, tint, tint);
     
     // Contrast enhancement
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.0f, 0.0f, 0.0f, 0.3f); // Darken mid-tones
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
+    const float darken[4] = { 0.0f, 0.0f, 0.0f, 0.3f }; // Darken mid-tones
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, 0);
+    AddOverlayQuad(geometry, 0, 0, w, h, darken, darken);
     
     // Smooth atmospheric gradient (sky to ground)
-    glBegin(GL_QUADS);
-    // Sky (top) - darker/cooler
-    glColor4f(0.0f, 0.0f, 0.0f, 0.25f);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    
-    // Horizon (middle) - neutral
-    glColor4f(0.0f, 0.0f, 0.0f, 0.05f);
-    glVertex2f(screenWidth, screenHeight * 0.5f);
-    glVertex2f(0, screenHeight * 0.5f);
-    glEnd();
-    
-    glBegin(GL_QUADS);
-    // Horizon (middle) - neutral  
-    glColor4f(0.1f, 0.15f, 0.1f, 0.05f);
-    glVertex2f(0, screenHeight * 0.5f);
-    glVertex2f(screenWidth, screenHeight * 0.5f);
-    
-    // Ground (bottom) - warmer
-    glColor4f(0.15f, 0.2f, 0.15f, 0.15f);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
+    const float sky[4] = { 0.0f, 0.0f, 0.0f, 0.25f };         // Sky (top) - darker/cooler
+    const float horizon[4] = { 0.0f, 0.0f, 0.0f, 0.05f };     // Horizon (middle) - neutral
+    const float horizonLow[4] = { 0.1f, 0.15f, 0.1f, 0.05f };
+    const float ground[4] = { 0.15f, 0.2f, 0.15f, 0.15f };    // Ground (bottom) - warmer
+    AddOverlayQuad(geometry, 0, 0, w, layout->horizonY, sky, horizon);
+    AddOverlayQuad(geometry, 0, layout->horizonY, w, h, horizonLow, ground);
+}
+
+void RenderSmartMonochrome(int screenWidth, int screenHeight)
+{
+    OverlayGeometry* geometry = GeometryToBuild(&gHybridGeometry[1], LayoutKey());
+    if (geometry) {
+        BuildSmartMonochrome(geometry, GetOverlayLayout());
+    }
+    
+    SubmitOverlayGeometry(&gHybridGeometry[1], OVERLAY_LAYER_FILTER);
 }
 
 // Smart thermal that mimics the post-processing look
-void RenderSmartThermal(int screenWidth, int screenHeight)
+static void BuildSmartThermal(OverlayGeometry* geometry, const OverlayLayout* layout)
 {
+    float w = layout->width;
+    float h = layout->height;
+    
     // Base inversion effect
-    glBlendFunc(GL_ONE_MINUS_DST_COLOR, GL_ZERO);
-    glColor4f(0.8f, 0.8f, 0.8f, 1.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
+    const float invert[4] = { 0.8f, 0.8f, 0.8f, 1.0f };
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_INVERT, 0.0f, 0);
+    AddOverlayQuad(geometry, 0, 0, w, h, invert, invert);
     
     // Prevent pure black - add minimum brightness
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.2f, 0.2f, 0.2f, 0.6f);
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
+    const float minimum[4] = { 0.2f, 0.2f, 0.2f, 0.6f };
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, 0);
+    AddOverlayQuad(geometry, 0, 0, w, h, minimum, minimum);
     
     // Smooth thermal gradient (cold sky to warm ground)
-    glBegin(GL_QUADS);
-    // Cold sky (top)
-    glColor4f(0.0f, 0.0f, 0.0f, 0.3f);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    
-    // Horizon (middle) - neutral
-    glColor4f(0.0f, 0.0f, 0.0f, 0.05f);
-    glVertex2f(screenWidth, screenHeight * 0.5f);
-    glVertex2f(0, screenHeight * 0.5f);
-    glEnd();
-    
-    glBegin(GL_QUADS);
-    // Horizon (middle) - neutral
-    glColor4f(0.1f, 0.1f, 0.1f, 0.05f);
-    glVertex2f(0, screenHeight * 0.5f);
-    glVertex2f(screenWidth, screenHeight * 0.5f);
-    
-    // Warm ground (bottom)
-    glColor4f(0.2f, 0.2f, 0.2f, 0.2f);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
+    const float sky[4] = { 0.0f, 0.0f, 0.0f, 0.3f };          // Cold sky (top)
+    const float horizon[4] = { 0.0f, 0.0f, 0.0f, 0.05f };     // Horizon (middle) - neutral
+    const float horizonLow[4] = { 0.1f, 0.1f, 0.1f, 0.05f };
+    const float ground[4] = { 0.2f, 0.2f, 0.2f, 0.2f };       // Warm ground (bottom)
+    AddOverlayQuad(geometry, 0, 0, w, layout->horizonY, sky, horizon);
+    AddOverlayQuad(geometry, 0, layout->horizonY, w, h, horizonLow, ground);
+}
+
+void RenderSmartThermal(int screenWidth, int screenHeight)
+{
+    OverlayGeometry* geometry = GeometryToBuild(&gHybridGeometry[2], LayoutKey());
+    if (geometry) {
+        BuildSmartThermal(geometry, GetOverlayLayout());
+    }
+    
+    SubmitOverlayGeometry(&gHybridGeometry[2], OVERLAY_LAYER_FILTER);
 }
 
 // Smart IR that mimics the post-processing look
-void RenderSmartIR(int screenWidth, int screenHeight)
+static void BuildSmartIR(OverlayGeometry* geometry, const OverlayLayout* layout)
 {
+    float w = layout->width;
+    float h = layout->height;
+    
     // High contrast base
-    glBlendFunc(GL_DST_COLOR, GL_ZERO);
-    glColor4f(0.3f, 0.3f, 0.3f, 1.0f); // Darken everything
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
-    
-    // Harsh contrast enhancement
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(1.0f, 1.0f, 1.0f, 0.4f); // Brighten highlights
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
-    
-    // Minimum visibility floor
-    glColor4f(0.15f, 0.15f, 0.15f, 0.7f);
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
+    const float darken[4] = { 0.3f, 0.3f, 0.3f, 1.0f }; // Darken everything
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_MULTIPLY, 0.0f, 0);
+    AddOverlayQuad(geometry, 0, 0, w, h, darken, darken);
+    
+    // Harsh contrast enhancement, then minimum visibility floor
+    const float highlight[4] = { 1.0f, 1.0f, 1.0f, 0.4f }; // Brighten highlights
+    const float minimum[4] = { 0.15f, 0.15f, 0.15f, 0.7f };
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, 0);
+    AddOverlayQuad(geometry, 0, 0, w, h, highlight, highlight);
+    AddOverlayQuad(geometry, 0, 0, w, h, minimum, minimum);
+}
+
+void RenderSmartIR(int screenWidth, int screenHeight)
+{
+    OverlayGeometry* geometry = GeometryToBuild(&gHybridGeometry[3], LayoutKey());
+    if (geometry) {
+        BuildSmartIR(geometry, GetOverlayLayout());
+    }
+    
+    SubmitOverlayGeometry(&gHybridGeometry[3], OVERLAY_LAYER_FILTER);
     
     // Add grid pattern for digital look
-    glColor4f(1.0f, 1.0f, 1.0f, 0.03f);
-    glLineWidth(1.0f);
-    glBegin(GL_LINES);
-    for (int x = 0; x < screenWidth; x += 16) {
-        glVertex2f(x, 0);
-        glVertex2f(x, screenHeight);
+    SubmitPattern(OVERLAY_PATTERN_GRID_16, OVERLAY_LAYER_FILTER, GRID_16_OPACITY);
+}
+
+// Runs a mode's overlay passes over a gray ramp with the software backend:
+// column x of band y ends up as whatever the passes turn level x into there.
+// Every pass is a per-pixel function of the destination and the band, so the
+// table reproduces the whole sequence.
+static void BuildHybridTransfer(int mode)
+{
+    OverlayLayout layout;
+    ComputeOverlayLayout(&layout, HYBRID_TRANSFER_LEVELS, HYBRID_TRANSFER_ROWS, 1.0f);
+    
+    for (int y = 0; y < HYBRID_TRANSFER_ROWS; y++) {
+        unsigned char* row = gHybridTransfer + y * HYBRID_TRANSFER_LEVELS * 4;
+        for (int x = 0; x < HYBRID_TRANSFER_LEVELS; x++) {
+            row[x * 4] = row[x * 4 + 1] = row[x * 4 + 2] = (unsigned char)x;
+            row[x * 4 + 3] = 255;
+        }
+    }
+    
+    ResetOverlayGeometry(&gHybridTransferGeometry, 0);
+    switch (mode) {
+        case 1: BuildSmartMonochrome(&gHybridTransferGeometry, &layout); break;
+        case 2: BuildSmartThermal(&gHybridTransferGeometry, &layout); break;
+        case 3: BuildSmartIR(&gHybridTransferGeometry, &layout); break;
+    }
+    
+    OverlayRasterTarget target = { gHybridTransfer, HYBRID_TRANSFER_LEVELS, HYBRID_TRANSFER_ROWS };
+    RasterizeOverlayGeometry(&target, &gHybridTransferGeometry);
+}
+
+static int RenderHybridLookup(int screenWidth, int screenHeight, int mode)
+{
+    if (!gHybridShaderEnabled) return 0;
+    
+    if (gHybridTransferMode != mode) {
+        BuildHybridTransfer(mode);
+        gHybridTransferMode = mode;
+        gHybridTransferVersion++;
     }
-    for (int y = 0; y < screenHeight; y += 16) {
-        glVertex2f(0, y);
-        glVertex2f(screenWidth, y);
+    
+    if (!RenderHybridShader(screenWidth, screenHeight, gHybridTransfer, gHybridTransferVersion)) {
+        gHybridShaderEnabled = 0;
+        return 0;
     }
-    glEnd();
+    return 1;
+}
+
+void SetShaderHybridModes(int enabled)
+{
+    gHybridShaderEnabled = enabled;
 }
 
 void SetMonochromeFilter(int enabled)
@@ -548,8 +1077,10 @@ void SetImageEnhancement(float brightness, float contrast)
 {
     gBrightness = brightness;
     gContrast = contrast;
+    gEnhancementVersion++;
 }
 
+// Submits into the overlay pass the caller has opened with BeginOverlayPass
 void RenderVisualEffects(int screenWidth, int screenHeight)
 {
     gFrameCounter++;
@@ -560,29 +1091,21 @@ void RenderVisualEffects(int screenWidth, int screenHeight)
     else if (gThermalEnabled) processingMode = 2;
     else if (gIREnabled) processingMode = 3;
     
-    // Try hybrid approach first (much faster but same visual quality)
-    if (gUseHybridMode && processingMode > 0) {
-        RenderHybridEffects(screenWidth, screenHeight, processingMode);
-        return;
+    // A range grid only describes the frame it was read from. Off the post path
+    // the readback buffers go, so a later switch back never applies an old grid.
+    if ((processingMode == 0 || gRenderer == FLIR_RENDERER_HYBRID) && gDepthWidth) {
+        ReleaseDepthReadback();
     }
     
-    // Fallback to post-processing (slower but works)
-    if (gPostProcessingEnabled && processingMode > 0) {
-        RenderPostProcessing(screenWidth, screenHeight);
-        
+    // Post-processing first; draws immediately, before the pass sets up its own projection
+    int drawn = processingMode > 0 && RenderPostProcessing(screenWidth, screenHeight);
+    
+    // Counts while the CPU kernel is still filling its readback ring; a shader
+    // that fell back has switched the renderer to hybrid by now
+    gPostProcessingActive = processingMode > 0 && gRenderer != FLIR_RENDERER_HYBRID && gPostProcessingEnabled;
+    
+    if (drawn) {
         // Still add overlays like noise and scan lines
-        glMatrixMode(GL_PROJECTION);
-        glPushMatrix();
-        glLoadIdentity();
-        glOrtho(0, screenWidth, screenHeight, 0, -1, 1);
-        
-        glMatrixMode(GL_MODELVIEW);
-        glPushMatrix();
-        glLoadIdentity();
-        
-        glDisable(GL_DEPTH_TEST);
-        glEnable(GL_BLEND);
-        
         if (gNoiseEnabled) {
             RenderCameraNoise(screenWidth, screenHeight);
         }
@@ -591,29 +1114,16 @@ void RenderVisualEffects(int screenWidth, int screenHeight)
             RenderScanLines(screenWidth, screenHeight);
         }
         
-        glEnable(GL_DEPTH_TEST);
-        glDisable(GL_BLEND);
-        glPopMatrix();
-        glMatrixMode(GL_PROJECTION);
-        glPopMatrix();
-        glMatrixMode(GL_MODELVIEW);
-        
         return;
     }
     
-    // Fallback to overlay mode if post-processing fails
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, screenWidth, screenHeight, 0, -1, 1);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    // Hybrid overlays when post-processing is off, unavailable or not ready yet
+    if (processingMode > 0) {
+        RenderHybridEffects(screenWidth, screenHeight, processingMode);
+        return;
+    }
     
+    // Fallback to overlay mode if post-processing fails
     if (gMonochromeEnabled) {
         RenderMonochromeFilter(screenWidth, screenHeight);
     }
@@ -629,170 +1139,120 @@ void RenderVisualEffects(int screenWidth, int screenHeight)
     if (gScanLinesEnabled) {
         RenderScanLines(screenWidth, screenHeight);
     }
-    
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
 }
 
 void RenderMonochromeFilter(int screenWidth, int screenHeight)
 {
-    glBlendFunc(GL_DST_COLOR, GL_ZERO);
-    glColor4f(0.3f, 1.0f, 0.3f, 1.0f);
-    
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
-    
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    float brightness_adj = (gBrightness - 1.0f) * 0.3f;
-    if (brightness_adj > 0) {
-        glColor4f(brightness_adj, brightness_adj, brightness_adj, 0.5f);
-    } else {
-        glColor4f(0.0f, 0.0f, 0.0f, -brightness_adj * 0.5f);
+    unsigned int key = LayoutKey() ^ ((unsigned int)gEnhancementVersion << 28);
+    OverlayGeometry* geometry = GeometryToBuild(&gFilterGeometry[0], key);
+    if (geometry) {
+        const OverlayLayout* layout = GetOverlayLayout();
+        float w = layout->width;
+        float h = layout->height;
+        
+        const float tint[4] = { 0.3f, 1.0f, 0.3f, 1.0f };
+        BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_MULTIPLY, 0.0f, 0);
+        AddOverlayQuad(geometry, 0, 0, w, h, tint, tint);
+        
+        float brightness_adj = (gBrightness - 1.0f) * 0.3f;
+        float brightness[4] = { 0.0f, 0.0f, 0.0f, -brightness_adj * 0.5f };
+        if (brightness_adj > 0) {
+            brightness[0] = brightness[1] = brightness[2] = brightness_adj;
+            brightness[3] = 0.5f;
+        }
+        BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, 0);
+        AddOverlayQuad(geometry, 0, 0, w, h, brightness, brightness);
+        
+        BuildRangeTickGeometry(geometry, GetOverlayLayout());
     }
     
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
-    
-    glColor4f(1.0f, 1.0f, 1.0f, 0.8f);
-    glLineWidth(1.0f);
-    
-    glBegin(GL_LINES);
-    for (int i = 0; i < 10; i++) {
-        float y = 50 + i * (screenHeight - 100) / 10.0f;
-        glVertex2f(10, y);
-        glVertex2f(25, y);
-    }
-    glEnd();
+    SubmitOverlayGeometry(&gFilterGeometry[0], OVERLAY_LAYER_FILTER);
 }
 
 void RenderThermalEffects(int screenWidth, int screenHeight)
 {
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(1.0f, 0.4f, 0.0f, 0.15f);
-    
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
-    
-    glColor4f(1.0f, 1.0f, 1.0f, 0.8f);
-    glLineWidth(1.0f);
-    
-    glBegin(GL_LINES);
-    for (int i = 0; i < 10; i++) {
-        float y = 50 + i * (screenHeight - 100) / 10.0f;
-        glVertex2f(10, y);
-        glVertex2f(25, y);
+    OverlayGeometry* geometry = GeometryToBuild(&gFilterGeometry[1], LayoutKey());
+    if (geometry) {
+        const float tint[4] = { 1.0f, 0.4f, 0.0f, 0.15f };
+        BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, 0);
+        const OverlayLayout* layout = GetOverlayLayout();
+        AddOverlayQuad(geometry, 0, 0, layout->width, layout->height, tint, tint);
+        
+        BuildRangeTickGeometry(geometry, GetOverlayLayout());
     }
-    glEnd();
+    
+    SubmitOverlayGeometry(&gFilterGeometry[1], OVERLAY_LAYER_FILTER);
 }
 
 void RenderCameraNoise(int screenWidth, int screenHeight)
 {
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    glColor4f(1.0f, 1.0f, 1.0f, gNoiseIntensity);
-    glPointSize(1.0f);
-    
-    glBegin(GL_POINTS);
+    if (!gNoiseTexturesReady || gNoiseTextureIntensity != gNoiseIntensity) {
+        gNoiseTexturesReady = BuildNoiseTextures(gNoiseTextures, gNoiseIntensity);
+        if (!gNoiseTexturesReady) return;
+        gNoiseTextureIntensity = gNoiseIntensity;
+        gNoiseGeometry.built = 0;
+    }
     
-    srand(gFrameCounter / 2);
+    // New noise every second frame: pick a baked frame and a random offset
+    unsigned int noiseSeed = HashOverlayFrame(gFrameCounter / 2);
+    int glitch = (gFrameCounter % 120) < 3;
+    unsigned int key = noiseSeed ^ LayoutKey() ^ (unsigned int)glitch;
     
-    int noisePoints = (screenWidth * screenHeight) / 2000;
-    for (int i = 0; i < noisePoints; i++) {
-        float x = rand() % screenWidth;
-        float y = rand() % screenHeight;
-        
-        float intensity = (rand() % 100) / 100.0f * gNoiseIntensity;
-        glColor4f(intensity, intensity, intensity, intensity);
-        glVertex2f(x, y);
+    OverlayGeometry* geometry = GeometryToBuild(&gNoiseGeometry, key);
+    if (geometry) {
+        BuildNoiseGeometry(geometry, gNoiseTextures, noiseSeed, glitch, GetOverlayLayout());
     }
     
-    glEnd();
+    SubmitOverlayGeometry(&gNoiseGeometry, OVERLAY_LAYER_EFFECTS);
+}
+
+static void SubmitPattern(int pattern, int layer, float opacity)
+{
+    if (!gPatternTexturesReady) {
+        gPatternTexturesReady = BuildPatternTextures(gPatternTextures);
+        if (!gPatternTexturesReady) return;
+    }
     
-    if ((gFrameCounter % 120) < 3) {
-        glColor4f(1.0f, 1.0f, 1.0f, 0.3f);
-        glLineWidth(1.0f);
-        
-        glBegin(GL_LINES);
-        for (int i = 0; i < 5; i++) {
-            float y = rand() % screenHeight;
-            glVertex2f(0, y);
-            glVertex2f(screenWidth, y);
-        }
-        glEnd();
+    // Opacity is part of the key so a changed value rebuilds the retained quad
+    unsigned int alpha = (unsigned int)(opacity * 255.0f + 0.5f) & 0xFF;
+    OverlayGeometry* geometry = GeometryToBuild(&gPatternGeometry[pattern], LayoutKey() ^ (alpha << 24));
+    if (geometry) {
+        const float* rgb = gPatternColors[pattern];
+        const float color[4] = { rgb[0], rgb[1], rgb[2], opacity };
+        BuildPatternGeometry(geometry, pattern, gPatternTextures[pattern], GetOverlayLayout(), color);
     }
+    
+    SubmitOverlayGeometry(&gPatternGeometry[pattern], layer);
 }
 
 void RenderScanLines(int screenWidth, int screenHeight)
 {
     if (gScanLineOpacity <= 0.0f) return;
     
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.0f, 0.0f, 0.0f, gScanLineOpacity);
-    glLineWidth(1.0f);
-    
-    glBegin(GL_LINES);
-    for (int y = 2; y < screenHeight; y += 3) {
-        glVertex2f(0, y);
-        glVertex2f(screenWidth, y);
-    }
-    glEnd();
+    SubmitPattern(OVERLAY_PATTERN_SCANLINES, OVERLAY_LAYER_EFFECTS, gScanLineOpacity);
 }
 
 void RenderIRFilter(int screenWidth, int screenHeight)
 {
-    glBlendFunc(GL_DST_COLOR, GL_ZERO);
-    
-    glColor4f(0.4f, 0.4f, 0.4f, 1.0f);
-    
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
-    
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    float contrast = gContrast * 1.5f;
-    glColor4f(contrast, contrast, contrast, 0.3f);
-    
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(screenWidth, 0);
-    glVertex2f(screenWidth, screenHeight);
-    glVertex2f(0, screenHeight);
-    glEnd();
-    
-    glColor4f(1.0f, 1.0f, 1.0f, 0.1f);
-    glLineWidth(1.0f);
-    
-    glBegin(GL_LINES);
-    for (int x = 0; x < screenWidth; x += 8) {
-        glVertex2f(x, 0);
-        glVertex2f(x, screenHeight);
-    }
-    for (int y = 0; y < screenHeight; y += 8) {
-        glVertex2f(0, y);
-        glVertex2f(screenWidth, y);
+    unsigned int key = LayoutKey() ^ ((unsigned int)gEnhancementVersion << 28);
+    OverlayGeometry* geometry = GeometryToBuild(&gFilterGeometry[2], key);
+    if (geometry) {
+        const OverlayLayout* layout = GetOverlayLayout();
+        float w = layout->width;
+        float h = layout->height;
+        
+        const float darken[4] = { 0.4f, 0.4f, 0.4f, 1.0f };
+        BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_MULTIPLY, 0.0f, 0);
+        AddOverlayQuad(geometry, 0, 0, w, h, darken, darken);
+        
+        float contrast = gContrast * 1.5f;
+        const float boost[4] = { contrast, contrast, contrast, 0.3f };
+        BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, 0);
+        AddOverlayQuad(geometry, 0, 0, w, h, boost, boost);
     }
-    glEnd();
+    
+    SubmitOverlayGeometry(&gFilterGeometry[2], OVERLAY_LAYER_FILTER);
+    SubmitPattern(OVERLAY_PATTERN_GRID_8, OVERLAY_LAYER_FILTER, GRID_8_OPACITY);
 }
 
 void CycleVisualModes()
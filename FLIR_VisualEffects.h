@@ -27,14 +27,50 @@
 #ifndef FLIR_VISUALEFFECTS_H
 #define FLIR_VISUALEFFECTS_H
 
+// Range buckets shared by the depth readback and the attenuation tables.
+// Buckets are spaced on a square-root scale out to FLIR_RANGE_MAX_METERS,
+// the last bucket is reserved for pixels that hit the far plane (sky).
+#define FLIR_RANGE_BUCKETS 64
+#define FLIR_RANGE_SKY_BUCKET (FLIR_RANGE_BUCKETS - 1)
+#define FLIR_RANGE_MAX_METERS 40000.0f
+
+// Per-mode transfer curves from the heat-adjusted gray level to output RGB,
+// shared by the CPU kernel and the GLSL path. Gray levels below
+// -FLIR_TRANSFER_OFFSET or past the end clamp to the first/last entry.
+#define FLIR_TRANSFER_SIZE 512
+#define FLIR_TRANSFER_OFFSET 128
+
+// Material classes the per-pixel classifier sorts pixels into, each mapped
+// to a heat offset in gray levels by the material heat table
+#define FLIR_MATERIAL_NEUTRAL 0
+#define FLIR_MATERIAL_SKY 1
+#define FLIR_MATERIAL_VEGETATION 2
+#define FLIR_MATERIAL_CONCRETE 3
+#define FLIR_MATERIAL_HOT 4
+#define FLIR_MATERIAL_SHADOW 5
+#define FLIR_MATERIAL_WATER 6
+#define FLIR_MATERIAL_COUNT 7
+
+// What draws the processing modes. Post-processing falls back to the hybrid
+// overlays when it cannot draw; selectable through flir/effects/renderer.
+#define FLIR_RENDERER_POST_SHADER 0 // Frame redrawn through the GLSL kernel every frame
+#define FLIR_RENDERER_POST_CPU 1    // CPU kernel on the skip cadence, streamed back as a texture
+#define FLIR_RENDERER_HYBRID 2      // Overlay passes approximating the kernel
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 void InitializeVisualEffects();
 void CleanupVisualEffects();
+// Effects are submitted into the caller's overlay pass (see FLIR_Overlay.h)
 void RenderVisualEffects(int screenWidth, int screenHeight);
-void RenderPostProcessing(int screenWidth, int screenHeight);
+int RenderPostProcessing(int screenWidth, int screenHeight);
+void SetVisualRenderer(int renderer);
+int GetVisualRenderer();
+// True while a visual mode is drawn by a post-processing renderer, the only
+// consumer of the terrain, weather and thermal inputs
+int IsPostProcessingActive();
 
 void SetMonochromeFilter(int enabled);
 void SetThermalMode(int enabled);
@@ -52,8 +88,16 @@ void RenderHybridEffects(int screenWidth, int screenHeight, int mode);
 void RenderSmartMonochrome(int screenWidth, int screenHeight);
 void RenderSmartThermal(int screenWidth, int screenHeight);
 void RenderSmartIR(int screenWidth, int screenHeight);
+void SetShaderHybridModes(int enabled);
 void GetVisualEffectsStatus(char* statusBuffer, int bufferSize);
 
+// Range-aware processing
+void SetDepthReadback(int enabled);
+int RangeToBucket(float rangeMeters);
+float BucketToRange(int bucket);
+void SetAttenuationTable(const unsigned short* table);
+void SetMaterialHeatTable(const int* table);
+
 #ifdef __cplusplus
 }
 #endif
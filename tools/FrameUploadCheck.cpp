@@ -0,0 +1,153 @@
+/*
+ * Headless check of the frame upload ring
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+// Built and run on the host by "make frameupload-check", on the same offscreen
+// EGL context as the shader check. Each upload method is forced in turn with
+// LimitFrameUploadMethod; every frame carries its own pattern, is drawn with
+// DrawUploadedFrame and read back, so a slot handed out while the GPU still
+// sources it, or a stale texture, shows up as a pixel mismatch. The ring must
+// cycle its slots, wait on the fence of every reused persistent slot without
+// dropping frames, and start over when the frame size changes.
+
+#include <stdio.h>
+#include <string.h>
+#include <GL/gl.h>
+
+#include "FLIR_FrameUpload.h"
+#include "HeadlessGL.h"
+
+#define CHECK_WIDTH 250             // Odd row length, catches unpack alignment mistakes
+#define CHECK_HEIGHT 140
+#define CHECK_RESIZED_WIDTH 122
+#define CHECK_RESIZED_HEIGHT 90
+#define CHECK_FRAMES 10
+#define CHECK_SLOTS 3
+
+static unsigned char gFrame[CHECK_WIDTH * CHECK_HEIGHT * 3];
+static unsigned char gReadback[CHECK_WIDTH * CHECK_HEIGHT * 3];
+
+static void FillFrame(unsigned char* pixels, int width, int height, int frame)
+{
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            for (int c = 0; c < 3; c++) {
+                pixels[(y * width + x) * 3 + c] = (unsigned char)((x * 3 + y * 7 + c * 11 + frame * 29) & 255);
+            }
+        }
+    }
+}
+
+// Uploads one frame through the ring (or client memory when the ring is off),
+// draws it and returns the number of bytes that came back wrong
+static int UploadAndCompare(int width, int height, int frame)
+{
+    unsigned char* memory = BeginFrameUpload(width, height);
+    if (memory) {
+        FillFrame(memory, width, height, frame);
+        EndFrameUpload();
+    } else {
+        FillFrame(gFrame, width, height, frame);
+        UploadFrame(gFrame, width, height);
+    }
+    FillFrame(gFrame, width, height, frame);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    if (!DrawUploadedFrame(width, height)) return width * height * 3;
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, gReadback);
+
+    int wrong = 0;
+    for (int i = 0; i < width * height * 3; i++) {
+        if (gReadback[i] != gFrame[i]) wrong++;
+    }
+    return wrong;
+}
+
+static int CheckMethod(int method, const char* name)
+{
+    int failures = 0;
+    FLIRFrameUploadStats stats;
+    int ring = method != FRAME_UPLOAD_CLIENT;
+
+    LimitFrameUploadMethod(method);
+    for (int frame = 0; frame < CHECK_FRAMES; frame++) {
+        int wrong = UploadAndCompare(CHECK_WIDTH, CHECK_HEIGHT, frame);
+        GetFrameUploadStats(&stats);
+        if (wrong) {
+            printf("%s: frame %d has %d wrong bytes\n", name, frame, wrong);
+            failures++;
+        }
+        if (ring && stats.slot != frame % CHECK_SLOTS) {
+            printf("%s: frame %d went through slot %d\n", name, frame, stats.slot);
+            failures++;
+        }
+    }
+
+    GetFrameUploadStats(&stats);
+    printf("%-10s uploads %2d fence waits %2d stalls %d\n", name, stats.uploads, stats.fenceWaits, stats.stalls);
+    if (stats.method != method) {
+        printf("%s: driver settled on method %d\n", name, stats.method);
+        failures++;
+    }
+    if (stats.uploads != (ring ? CHECK_FRAMES : 0)) {
+        printf("%s: %d frames went through the ring\n", name, stats.uploads);
+        failures++;
+    }
+    // Only persistent slots are fenced; each reuse after the first lap checks one
+    int expectedWaits = method == FRAME_UPLOAD_PERSISTENT ? CHECK_FRAMES - CHECK_SLOTS : 0;
+    if (stats.fenceWaits != expectedWaits || stats.stalls) {
+        printf("%s: expected %d fence waits and no stalls\n", name, expectedWaits);
+        failures++;
+    }
+
+    // A new size rebuilds the ring from slot 0
+    int wrong = UploadAndCompare(CHECK_RESIZED_WIDTH, CHECK_RESIZED_HEIGHT, CHECK_FRAMES);
+    GetFrameUploadStats(&stats);
+    if (wrong || (ring && stats.slot != 0)) {
+        printf("%s: resized frame has %d wrong bytes, slot %d\n", name, wrong, stats.slot);
+        failures++;
+    }
+    return failures;
+}
+
+int main()
+{
+    if (!CreateHeadlessContext(CHECK_WIDTH, CHECK_HEIGHT)) {
+        printf("no offscreen GL context (try EGL_PLATFORM=surfaceless)\n");
+        return 2;
+    }
+
+    int failures = 0;
+    failures += CheckMethod(FRAME_UPLOAD_PERSISTENT, "persistent");
+    failures += CheckMethod(FRAME_UPLOAD_ORPHAN, "orphan");
+    failures += CheckMethod(FRAME_UPLOAD_CLIENT, "client");
+    ReleaseFrameUpload();
+
+    printf(failures ? "frame upload check FAILED (%d)\n" : "frame upload check passed\n", failures);
+    return failures ? 1 : 0;
+}
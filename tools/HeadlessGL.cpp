@@ -0,0 +1,95 @@
+/*
+ * Offscreen GL context and the XPLM graphics calls for the headless checks
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdio.h>
+#include <EGL/egl.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "XPLMGraphics.h"
+#include "XPLMUtilities.h"
+#include "HeadlessGL.h"
+
+void XPLMDebugString(const char* inString)
+{
+    fputs(inString, stdout);
+}
+
+void XPLMGenerateTextureNumbers(int* outTextureIDs, int inCount)
+{
+    glGenTextures(inCount, (GLuint*)outTextureIDs);
+}
+
+// Binds on the given unit and leaves unit 0 active again
+void XPLMBindTexture2d(int inTextureNum, int inTextureUnit)
+{
+    static PFNGLACTIVETEXTUREPROC activeTexture = (PFNGLACTIVETEXTUREPROC)eglGetProcAddress("glActiveTexture");
+    activeTexture(GL_TEXTURE0 + inTextureUnit);
+    glBindTexture(GL_TEXTURE_2D, inTextureNum);
+    activeTexture(GL_TEXTURE0);
+}
+
+// Only the parts the plugin's 2D drawing depends on
+void XPLMSetGraphicsState(int inEnableFog, int inNumberTexUnits, int inEnableLighting, int inEnableAlphaTesting,
+                          int inEnableAlphaBlending, int inEnableDepthTesting, int inEnableDepthWriting)
+{
+    if (inNumberTexUnits) glEnable(GL_TEXTURE_2D); else glDisable(GL_TEXTURE_2D);
+    if (inEnableAlphaBlending) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+}
+
+int CreateHeadlessContext(int width, int height)
+{
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL)) return 0;
+
+    EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_DEPTH_SIZE, 24,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || !configCount) return 0;
+
+    EGLint surfaceAttributes[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    eglBindAPI(EGL_OPENGL_API);
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+    if (surface == EGL_NO_SURFACE || context == EGL_NO_CONTEXT) return 0;
+    if (!eglMakeCurrent(display, surface, surface, context)) return 0;
+
+    glViewport(0, 0, width, height);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0, width, 0, height, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    printf("GL %s / %s\n", glGetString(GL_VERSION), glGetString(GL_RENDERER));
+    return 1;
+}
@@ -0,0 +1,39 @@
+/*
+ * Offscreen GL context and the XPLM graphics calls for the headless checks
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef FLIR_TOOLS_HEADLESSGL_H
+#define FLIR_TOOLS_HEADLESSGL_H
+
+// The matching .cpp also stands in for XPLMDebugString, XPLMGenerateTextureNumbers,
+// XPLMBindTexture2d and XPLMSetGraphicsState, so GL modules link without the sim.
+
+// Makes a desktop GL context with a width x height pbuffer current, set up with
+// the sim's 2D window projection (origin bottom left). Needs an EGL driver that
+// can run offscreen, e.g. Mesa with EGL_PLATFORM=surfaceless. Returns 0 on failure.
+int CreateHeadlessContext(int width, int height);
+
+#endif // FLIR_TOOLS_HEADLESSGL_H
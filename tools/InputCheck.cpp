@@ -0,0 +1,144 @@
+/*
+ * Headless check of frame-rate independent pointer slews
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+// Built and run on the host by "make input-check". The sim is reduced to a
+// clock, a pointer and the gimbal's flight loop, which the check calls itself
+// at a chosen frame rate. The same 200 px drag over one second, sampled as
+// whole pixels each frame like XPLMGetMouseLocationGlobal reports it, must
+// settle the turret on the same pan and tilt at every frame rate, including
+// rates above the gimbal's 120 Hz step and uneven frame times.
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "XPLMProcessing.h"
+#include "XPLMDisplay.h"
+#include "FLIR_SimState.h"
+#include "FLIR_Mount.h"
+#include "FLIR_Optics.h"
+#include "FLIR_Input.h"
+#include "FLIR_Gimbal.h"
+
+#define CHECK_DRAG_X 200.0          // Pixels right over the drag
+#define CHECK_DRAG_Y -50.0          // Pixels toward the top of the screen
+#define CHECK_DRAG_TIME 1.0
+#define CHECK_SETTLE_TIME 2.0       // Long enough for both axes to stop
+#define CHECK_TOLERANCE 0.001f      // Degrees
+
+static FLIRSimState gState;
+static XPLMFlightLoop_f gLoop = NULL;
+static double gTime = 0.0;
+static double gPointerX = 0.0;
+static double gPointerY = 0.0;
+
+// Just enough of the sim for the gimbal, input and optics modules
+extern "C" {
+
+XPLMFlightLoopID XPLMCreateFlightLoop(XPLMCreateFlightLoop_t* inParams)
+{
+    gLoop = inParams->callbackFunc;
+    return (XPLMFlightLoopID)1;
+}
+void XPLMScheduleFlightLoop(XPLMFlightLoopID inFlightLoopID, float inInterval, int inRelativeToNow) { }
+void XPLMDestroyFlightLoop(XPLMFlightLoopID inFlightLoopID) { }
+float XPLMGetElapsedTime() { return (float)gTime; }
+
+void XPLMGetMouseLocationGlobal(int* outX, int* outY)
+{
+    *outX = (int)floor(gPointerX);
+    *outY = (int)floor(gPointerY);
+}
+
+}
+
+const FLIRSimState* GetSimState() { return &gState; }
+void RefreshSimState() { }
+int GetSimStateAge() { return 0; }
+
+// Runs the drag with frame times alternating between the two values and
+// returns the settled gimbal angles
+static void RunDrag(float frameTimeA, float frameTimeB, float* outPan, float* outTilt)
+{
+    memset(&gState, 0, sizeof(gState));
+    gState.valid = 1;
+    gTime = 0.0;
+    gPointerX = gPointerY = 0.0;
+
+    InitializeMount();
+    InitializeOptics();
+    InitializeInput();
+    InitializeGimbal();
+    // Body-fixed, so only the input path moves the turret
+    SetGimbalStabilization(0);
+    SetInputEnabled(1);
+
+    // First call anchors the pointer
+    gLoop(frameTimeA, 0.0f, 0, NULL);
+    for (int frame = 1; gTime < CHECK_DRAG_TIME + CHECK_SETTLE_TIME; frame++) {
+        float frameTime = (frame & 1) ? frameTimeA : frameTimeB;
+        gTime += frameTime;
+        gState.cycle++;
+        double drag = gTime < CHECK_DRAG_TIME ? gTime / CHECK_DRAG_TIME : 1.0;
+        gPointerX = CHECK_DRAG_X * drag;
+        gPointerY = CHECK_DRAG_Y * drag;
+        gLoop(frameTime, 0.0f, frame, NULL);
+    }
+    GetGimbalAngles(outPan, outTilt);
+}
+
+int main()
+{
+    static const float frameTimes[][2] = {
+        { 1.0f / 20.0f, 1.0f / 20.0f },
+        { 1.0f / 60.0f, 1.0f / 60.0f },
+        { 1.0f / 120.0f, 1.0f / 120.0f },
+        { 1.0f / 240.0f, 1.0f / 240.0f },   // Frames with no gimbal step due carry their slew over
+        { 1.0f / 30.0f, 1.0f / 90.0f }  // Uneven pacing
+    };
+    int runs = sizeof(frameTimes) / sizeof(frameTimes[0]);
+    int failures = 0;
+
+    // 0.2 degrees per pixel at the zoom the optics start in
+    InitializeOptics();
+    float degreesPerPixel = 0.2f * GetOpticsSensitivity();
+    float expectedPan = (float)CHECK_DRAG_X * degreesPerPixel;
+    float expectedTilt = -15.0f - (float)CHECK_DRAG_Y * degreesPerPixel;
+
+    for (int i = 0; i < runs; i++) {
+        float pan, tilt;
+        RunDrag(frameTimes[i][0], frameTimes[i][1], &pan, &tilt);
+        printf("%5.1f/%5.1f fps: pan %.4f tilt %.4f\n", 1.0f / frameTimes[i][0], 1.0f / frameTimes[i][1], pan, tilt);
+        if (fabsf(pan - expectedPan) > CHECK_TOLERANCE || fabsf(tilt - expectedTilt) > CHECK_TOLERANCE) {
+            printf("expected pan %.4f tilt %.4f\n", expectedPan, expectedTilt);
+            failures++;
+        }
+    }
+
+    printf(failures ? "input check FAILED (%d)\n" : "input check passed\n", failures);
+    return failures ? 1 : 0;
+}
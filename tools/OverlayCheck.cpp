@@ -0,0 +1,255 @@
+/*
+ * Headless check of the overlay content against golden images
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+// Built and run on the host by "make overlay-check". The overlay modules never
+// touch GL or XPLM, so the reticle, noise, pattern and text overlays are built
+// as in the plugin, rendered through the software backend into RGBA and
+// compared against the images in tools/golden. After an intended change to
+// the overlays, rerun with --update to rewrite the images and review them.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FLIR_Overlay.h"
+#include "FLIR_OverlayContent.h"
+#include "FLIR_OverlayRaster.h"
+
+#define CHECK_WIDTH 192
+#define CHECK_HEIGHT 144
+#define CHECK_TOLERANCE 1           // Rounding may differ by one step between compilers
+#define CHECK_GOLDEN_DIR "tools/golden/"
+
+static unsigned char gPixels[CHECK_WIDTH * CHECK_HEIGHT * 4];
+static unsigned char gGolden[CHECK_WIDTH * CHECK_HEIGHT * 4];
+static OverlayGeometry gGeometry[4];
+static int gNoiseTextures[OVERLAY_NOISE_FRAMES];
+static int gPatternTextures[OVERLAY_PATTERN_COUNT];
+static int gUpdate = 0;
+
+static const char* gHeader = "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+
+// Opaque gradient under every scene, so the blends have something to work on
+static void ClearTarget()
+{
+    for (int y = 0; y < CHECK_HEIGHT; y++) {
+        for (int x = 0; x < CHECK_WIDTH; x++) {
+            unsigned char* pixel = &gPixels[(y * CHECK_WIDTH + x) * 4];
+            pixel[0] = (unsigned char)(x * 255 / (CHECK_WIDTH - 1));
+            pixel[1] = (unsigned char)(y * 255 / (CHECK_HEIGHT - 1));
+            pixel[2] = 128;
+            pixel[3] = 255;
+        }
+    }
+}
+
+static int WriteGolden(const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file) return 0;
+    fprintf(file, gHeader, CHECK_WIDTH, CHECK_HEIGHT);
+    int written = fwrite(gPixels, sizeof(gPixels), 1, file) == 1;
+    fclose(file);
+    return written;
+}
+
+static int ReadGolden(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+
+    char expected[128];
+    char header[128];
+    snprintf(expected, sizeof(expected), gHeader, CHECK_WIDTH, CHECK_HEIGHT);
+    size_t length = strlen(expected);
+    int ok = fread(header, length, 1, file) == 1 && memcmp(header, expected, length) == 0 &&
+             fread(gGolden, sizeof(gGolden), 1, file) == 1;
+    fclose(file);
+    return ok;
+}
+
+// Rasterizes the open pass and compares it with (or, with --update, writes) the golden image
+static int FinishScene(const char* name, int expectedBatches)
+{
+    ClearTarget();
+    OverlayRasterTarget target = { gPixels, CHECK_WIDTH, CHECK_HEIGHT };
+    RasterizeOverlayPass(&target);
+
+    int batches;
+    long long fragments;
+    GetOverlayRasterStats(&batches, &fragments);
+
+    char path[256];
+    snprintf(path, sizeof(path), CHECK_GOLDEN_DIR "overlay_%s.pam", name);
+    if (gUpdate) {
+        printf("%-10s %d batches %6lld fragments, wrote %s\n", name, batches, fragments, path);
+        return WriteGolden(path) ? 0 : 1;
+    }
+
+    int failures = 0;
+    int differing = 0, maxDifference = 0;
+    if (!ReadGolden(path)) {
+        printf("%s: cannot read %s\n", name, path);
+        return 1;
+    }
+    for (int i = 0; i < CHECK_WIDTH * CHECK_HEIGHT * 4; i++) {
+        int difference = abs(gPixels[i] - gGolden[i]);
+        if (difference > maxDifference) maxDifference = difference;
+        if (difference > CHECK_TOLERANCE) differing++;
+    }
+
+    printf("%-10s %d batches %6lld fragments, %d differing channels (max %d)\n",
+           name, batches, fragments, differing, maxDifference);
+    if (differing) failures++;
+    if (batches != expectedBatches || fragments <= 0) {
+        printf("%s: expected %d batches with fragments\n", name, expectedBatches);
+        failures++;
+    }
+    return failures;
+}
+
+static int CheckReticle(const OverlayLayout* layout)
+{
+    ResetOverlayGeometry(&gGeometry[0], layout->key);
+    BuildReticleGeometry(&gGeometry[0], layout, 0);
+    ResetOverlayGeometry(&gGeometry[1], layout->key);
+    BuildRangeTickGeometry(&gGeometry[1], layout);
+
+    BeginOverlayPass(layout);
+    SubmitOverlayGeometry(&gGeometry[1], OVERLAY_LAYER_FILTER);
+    SubmitOverlayGeometry(&gGeometry[0], OVERLAY_LAYER_SYMBOLOGY);
+    return FinishScene("reticle", gGeometry[0].batchCount + gGeometry[1].batchCount);
+}
+
+// Full intensity so the sparse dots stand out; glitch lines on top
+static int CheckNoise(const OverlayLayout* layout)
+{
+    if (!BuildNoiseTextures(gNoiseTextures, 1.0f)) {
+        printf("noise: no textures\n");
+        return 1;
+    }
+    ResetOverlayGeometry(&gGeometry[0], layout->key);
+    BuildNoiseGeometry(&gGeometry[0], gNoiseTextures, HashOverlayFrame(7), 1, layout);
+
+    BeginOverlayPass(layout);
+    SubmitOverlayGeometry(&gGeometry[0], OVERLAY_LAYER_EFFECTS);
+    return FinishScene("noise", 2);
+}
+
+// Scan lines as effects, both grids on the filter layer underneath
+static int CheckPatterns(const OverlayLayout* layout)
+{
+    static const float colors[OVERLAY_PATTERN_COUNT][4] = {
+        { 0.0f, 0.0f, 0.0f, 0.6f }, { 0.0f, 1.0f, 0.0f, 0.8f }, { 1.0f, 1.0f, 1.0f, 0.5f }
+    };
+    if (!BuildPatternTextures(gPatternTextures)) {
+        printf("patterns: no textures\n");
+        return 1;
+    }
+
+    BeginOverlayPass(layout);
+    for (int p = 0; p < OVERLAY_PATTERN_COUNT; p++) {
+        ResetOverlayGeometry(&gGeometry[p], layout->key);
+        BuildPatternGeometry(&gGeometry[p], p, gPatternTextures[p], layout, colors[p]);
+        SubmitOverlayGeometry(&gGeometry[p], p == OVERLAY_PATTERN_SCANLINES ? OVERLAY_LAYER_EFFECTS : OVERLAY_LAYER_FILTER);
+    }
+    return FinishScene("patterns", OVERLAY_PATTERN_COUNT);
+}
+
+// Every glyph of the built-in font, lowercase folding and a scaled label
+static int CheckText(const OverlayLayout* layout)
+{
+    static const float green[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+    static const float amber[4] = { 1.0f, 0.7f, 0.0f, 0.8f };
+
+    ResetOverlayGeometry(&gGeometry[0], layout->key);
+    AddOverlayText(&gGeometry[0], 4, 4, layout->textScale, "ABCDEFGHIJKLMNOPQRSTUVWXYZ", green);
+    AddOverlayText(&gGeometry[0], 4, 16, layout->textScale, "0123456789 %()+-./:", green);
+    AddOverlayText(&gGeometry[0], 4, 28, layout->textScale, "lock & #", green);
+    AddOverlayText(&gGeometry[0], 4, 48, layout->textScale * 3.0f, "RNG 1500M", amber);
+
+    BeginOverlayPass(layout);
+    SubmitOverlayGeometry(&gGeometry[0], OVERLAY_LAYER_SYMBOLOGY);
+    return FinishScene("text", 4);
+}
+
+// A batch past the limit must not leak its vertices into the previous one
+static int CheckBatchLimits()
+{
+    static const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    OverlayGeometry* geometry = &gGeometry[0];
+    int failures = 0;
+
+    ResetOverlayGeometry(geometry, 1);
+    for (int i = 0; i < OVERLAY_MAX_BATCHES; i++) {
+        BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, 0);
+        AddOverlayQuad(geometry, 0, 0, 1, 1, white, white);
+    }
+    int accepted = BeginOverlayBatch(geometry, OVERLAY_PRIM_LINES, OVERLAY_BLEND_INVERT, 2.0f, 0);
+    AddOverlayVertex(geometry, 0, 0, 1, 1, 1, 1);
+    AddOverlayQuad(geometry, 0, 0, 1, 1, white, white);
+    if (accepted || !geometry->overflow || geometry->vertexCount != OVERLAY_MAX_BATCHES * 4 ||
+        geometry->batches[OVERLAY_MAX_BATCHES - 1].count != 4) {
+        printf("batch limit: extra batch accepted %d, %d vertices\n", accepted, geometry->vertexCount);
+        failures++;
+    }
+
+    // Quads are dropped whole when fewer than four vertices are left
+    ResetOverlayGeometry(geometry, 1);
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_POINTS, OVERLAY_BLEND_ALPHA, 1.0f, 0);
+    for (int i = 0; i < OVERLAY_MAX_VERTICES - 2; i++) {
+        AddOverlayVertex(geometry, 0, 0, 1, 1, 1, 1);
+    }
+    BeginOverlayBatch(geometry, OVERLAY_PRIM_QUADS, OVERLAY_BLEND_ALPHA, 0.0f, 0);
+    AddOverlayQuad(geometry, 0, 0, 1, 1, white, white);
+    if (geometry->overflow || geometry->vertexCount != OVERLAY_MAX_VERTICES - 2 || geometry->batches[1].count) {
+        printf("vertex limit: %d vertices, partial quad of %d\n", geometry->vertexCount, geometry->batches[1].count);
+        failures++;
+    }
+    return failures;
+}
+
+int main(int argc, char** argv)
+{
+    gUpdate = argc > 1 && strcmp(argv[1], "--update") == 0;
+
+    const OverlayLayout* layout = UpdateOverlayLayout(CHECK_WIDTH, CHECK_HEIGHT, 1.0f);
+    int failures = 0;
+    failures += CheckReticle(layout);
+    failures += CheckNoise(layout);
+    failures += CheckPatterns(layout);
+    failures += CheckText(layout);
+    failures += CheckBatchLimits();
+    ReleaseOverlayTextures();
+
+    if (gUpdate) {
+        printf(failures ? "overlay golden images NOT written (%d)\n" : "overlay golden images written\n", failures);
+    } else {
+        printf(failures ? "overlay check FAILED (%d)\n" : "overlay check passed\n", failures);
+    }
+    return failures ? 1 : 0;
+}
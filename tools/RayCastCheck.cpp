@@ -0,0 +1,174 @@
+/*
+ * Headless check of the terrain ray marcher against a synthetic heightfield
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+// Built and run on the host by "make raycast-check". The XPLM entry points the
+// ray caster touches are stubbed below and the terrain comes in through
+// SetRayCastProbe, so no sim is needed.
+
+#include <stdio.h>
+#include <math.h>
+
+#include "XPLMDataAccess.h"
+#include "XPLMScenery.h"
+#include "XPLMGraphics.h"
+#include "FLIR_RayCast.h"
+
+#define CHECK_RAYS 200
+#define CHECK_MAX_RANGE 30000.0f
+#define CHECK_MAX_ERROR 1.0f        // Meters between the hit and the surface below it
+#define CHECK_SCAN_STEP 1.0f        // Brute-force spacing for the earlier-crossing scan
+#define CHECK_MAX_REPEAT_COST 0.25f // Probes a repeated ray may spend, relative to its first cast
+
+XPLMProbeRef XPLMCreateProbe(XPLMProbeType inProbeType) { return NULL; }
+void XPLMDestroyProbe(XPLMProbeRef inProbe) { }
+XPLMProbeResult XPLMProbeTerrainXYZ(XPLMProbeRef inProbe, float inX, float inY, float inZ, XPLMProbeInfo_t* outInfo)
+{
+    return xplm_ProbeMissed;
+}
+void XPLMLocalToWorld(double inX, double inY, double inZ, double* outLatitude, double* outLongitude, double* outAltitude)
+{
+    *outLatitude = *outLongitude = *outAltitude = 0.0;
+}
+XPLMDataRef XPLMRegisterDataAccessor(const char* inDataName, XPLMDataTypeID inDataType, int inIsWritable,
+                                     XPLMGetDatai_f inReadInt, XPLMSetDatai_f inWriteInt,
+                                     XPLMGetDataf_f inReadFloat, XPLMSetDataf_f inWriteFloat,
+                                     XPLMGetDatad_f inReadDouble, XPLMSetDatad_f inWriteDouble,
+                                     XPLMGetDatavi_f inReadIntArray, XPLMSetDatavi_f inWriteIntArray,
+                                     XPLMGetDatavf_f inReadFloatArray, XPLMSetDatavf_f inWriteFloatArray,
+                                     XPLMGetDatab_f inReadData, XPLMSetDatab_f inWriteData,
+                                     void* inReadRefcon, void* inWriteRefcon)
+{
+    return NULL;
+}
+void XPLMUnregisterDataAccessor(XPLMDataRef inDataRef) { }
+
+// Rolling hills with a shorter ripple on top, steep enough to make coarse steps overshoot
+static float Height(float x, float z)
+{
+    return 40.0f * sinf(x * 0.004f) * cosf(z * 0.003f) + 15.0f * sinf(x * 0.03f + z * 0.02f);
+}
+
+static int ProbeHeightfield(float x, float y, float z, float* outTerrainY, void* refcon)
+{
+    *outTerrainY = Height(x, z);
+    return 1;
+}
+
+// A fan of downward rays from points along a diagonal, 1500 m up
+static void MakeRay(int index, float origin[3], float dir[3])
+{
+    float pitch = 0.1f + index * 0.003f;
+    float heading = index * 0.07f;
+
+    origin[0] = index * 37.0f;
+    origin[1] = 1500.0f;
+    origin[2] = -index * 11.0f;
+    dir[0] = cosf(heading) * cosf(pitch);
+    dir[1] = -sinf(pitch);
+    dir[2] = sinf(heading) * cosf(pitch);
+}
+
+int main()
+{
+    int failures = 0;
+    float maxError = 0.0f;
+
+    InitializeRayCast();
+    SetRayCastProbe(ProbeHeightfield, NULL);
+
+    for (int i = 0; i < CHECK_RAYS; i++) {
+        float origin[3], dir[3];
+        FLIRRayMarch march;
+        MakeRay(i, origin, dir);
+
+        if (CastTerrainRay(origin, dir, CHECK_MAX_RANGE, &march) != RAY_HIT) {
+            printf("ray %d: no hit\n", i);
+            failures++;
+            continue;
+        }
+
+        float error = fabsf(march.y - Height(march.x, march.z));
+        if (error > maxError) maxError = error;
+        if (error > CHECK_MAX_ERROR) {
+            printf("ray %d: hit %.2f m off the surface\n", i, error);
+            failures++;
+        }
+
+        // A step that jumped over a ridge would report a later crossing than the first one
+        for (float t = 0.0f; t < march.distance - CHECK_SCAN_STEP * 2.0f; t += CHECK_SCAN_STEP) {
+            if (origin[1] + dir[1] * t < Height(origin[0] + dir[0] * t, origin[2] + dir[2] * t)) {
+                printf("ray %d: crossing at %.0f m missed, reported %.0f m\n", i, t, march.distance);
+                failures++;
+                break;
+            }
+        }
+    }
+
+    FLIRRayCastStats stats;
+    GetRayCastStats(&stats);
+    printf("first pass: %d rays, max error %.3f m, %u probes, hit rate %.2f\n",
+           CHECK_RAYS, maxError, stats.probes, stats.hitRate);
+
+    // A tracker re-casts the same ray every frame; the repeat should come from the cache
+    unsigned int firstProbes = 0;
+    unsigned int repeatProbes = 0;
+    for (int i = 0; i < CHECK_RAYS; i++) {
+        float origin[3], dir[3];
+        FLIRRayMarch march;
+        MakeRay(i, origin, dir);
+        CastTerrainRay(origin, dir, CHECK_MAX_RANGE, &march);
+        firstProbes += march.probes;
+        CastTerrainRay(origin, dir, CHECK_MAX_RANGE, &march);
+        repeatProbes += march.probes;
+    }
+    GetRayCastStats(&stats);
+    printf("repeated rays: %u probes first, %u on repeat, hit rate %.2f\n", firstProbes, repeatProbes, stats.hitRate);
+    if (repeatProbes > firstProbes * CHECK_MAX_REPEAT_COST) {
+        printf("repeat casts cost more than %.0f%% of the first\n", CHECK_MAX_REPEAT_COST * 100.0f);
+        failures++;
+    }
+
+    // Level line well above the highest terrain
+    float from[3] = { 0.0f, 100.0f, 0.0f };
+    float to[3] = { 5000.0f, 100.0f, 0.0f };
+    if (!IsLineOfSightClear(from, to)) {
+        printf("line of sight above the terrain reported blocked\n");
+        failures++;
+    }
+    // Descending below the lowest valley before the far end
+    to[0] = 3000.0f;
+    to[1] = -100.0f;
+    if (IsLineOfSightClear(from, to)) {
+        printf("line of sight through the terrain reported clear\n");
+        failures++;
+    }
+
+    CleanupRayCast();
+
+    printf(failures ? "raycast check FAILED (%d)\n" : "raycast check passed\n", failures);
+    return failures ? 1 : 0;
+}
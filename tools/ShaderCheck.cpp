@@ -0,0 +1,225 @@
+/*
+ * Headless check of the GLSL post-processing path against the CPU kernel
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 sebastian <sebastian@eingabeausgabe.io>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+// Built and run on the host by "make shader-check". Needs an EGL driver that
+// can make an offscreen desktop GL context; Mesa's llvmpipe does, run with
+// EGL_PLATFORM=surfaceless when there is no display. The same synthetic frame
+// and depth buffer go through RenderPostProcessing once with the shader and
+// once with the CPU kernel, and the two results must match exactly. The shader
+// is the plugin's default renderer and must not fall back along the way.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <GL/gl.h>
+
+#include "XPLMDataAccess.h"
+#include "XPLMGraphics.h"
+#include "XPLMUtilities.h"
+#include "FLIR_Camera.h"
+#include "FLIR_TerrainClassifier.h"
+#include "FLIR_VisualEffects.h"
+#include "HeadlessGL.h"
+
+#define CHECK_WIDTH 256
+#define CHECK_HEIGHT 144
+#define CHECK_NEAR 1.0f
+#define CHECK_FAR 50000.0f
+#define CHECK_WARMUP_FRAMES 12
+#define CHECK_CPU_FRAMES 6          // Enough for the async readback and depth rings to settle
+
+static unsigned char gScene[CHECK_WIDTH * CHECK_HEIGHT * 3];
+static float gDepth[CHECK_WIDTH * CHECK_HEIGHT];
+static unsigned char gTerrainMask[FLIR_TERRAIN_MASK_WIDTH * FLIR_TERRAIN_MASK_HEIGHT];
+static int gHorizonValid = 0;
+
+// Just enough of the sim for the effects modules beyond HeadlessGL: datarefs with
+// a fixed projection, and a camera pose
+extern "C" {
+
+XPLMDataRef XPLMFindDataRef(const char* inDataRefName) { return (XPLMDataRef)1; }
+int XPLMGetDatai(XPLMDataRef inDataRef) { return 0; }
+
+int XPLMGetDatavf(XPLMDataRef inDataRef, float* outValues, int inOffset, int inMax)
+{
+    memset(outValues, 0, sizeof(float) * 16);
+    outValues[0] = 1.0f;
+    outValues[5] = 1.0f;
+    outValues[10] = -(CHECK_FAR + CHECK_NEAR) / (CHECK_FAR - CHECK_NEAR);
+    outValues[11] = -1.0f;
+    outValues[14] = -2.0f * CHECK_FAR * CHECK_NEAR / (CHECK_FAR - CHECK_NEAR);
+    return 16;
+}
+
+XPLMDataRef XPLMRegisterDataAccessor(const char* inDataName, XPLMDataTypeID inDataType, int inIsWritable,
+                                     XPLMGetDatai_f inReadInt, XPLMSetDatai_f inWriteInt,
+                                     XPLMGetDataf_f inReadFloat, XPLMSetDataf_f inWriteFloat,
+                                     XPLMGetDatad_f inReadDouble, XPLMSetDatad_f inWriteDouble,
+                                     XPLMGetDatavi_f inReadIntArray, XPLMSetDatavi_f inWriteIntArray,
+                                     XPLMGetDatavf_f inReadFloatArray, XPLMSetDatavf_f inWriteFloatArray,
+                                     XPLMGetDatab_f inReadData, XPLMSetDatab_f inWriteData,
+                                     void* inReadRefcon, void* inWriteRefcon)
+{
+    return NULL;
+}
+void XPLMUnregisterDataAccessor(XPLMDataRef inDataRef) { }
+
+}
+
+void GetFLIRCameraView(FLIRCameraView* outView)
+{
+    memset(outView, 0, sizeof(*outView));
+    outView->valid = gHorizonValid;
+    outView->pitch = 2.0f;
+    outView->roll = 10.0f;
+    outView->fovVertical = 30.0f;
+    outView->elevation = 500.0f;
+}
+
+const unsigned char* GetTerrainClassMask()
+{
+    return gTerrainMask;
+}
+
+// Random pixels with a third of them forced onto the sky, vegetation, concrete
+// and shadow materials; the top quarter of the depth buffer is sky
+static void BuildScene()
+{
+    srand(7);
+    for (int i = 0; i < CHECK_WIDTH * CHECK_HEIGHT * 3; i++) gScene[i] = rand() & 255;
+
+    static const unsigned char materials[4][3] = {
+        { 60, 90, 200 }, { 50, 160, 40 }, { 128, 128, 128 }, { 10, 10, 10 }
+    };
+    for (int i = 0; i < CHECK_WIDTH * CHECK_HEIGHT / 3; i++) {
+        unsigned char* pixel = gScene + (rand() % (CHECK_WIDTH * CHECK_HEIGHT)) * 3;
+        memcpy(pixel, materials[rand() % 4], 3);
+    }
+
+    for (int i = 0; i < FLIR_TERRAIN_MASK_WIDTH * FLIR_TERRAIN_MASK_HEIGHT; i++) {
+        gTerrainMask[i] = (unsigned char)((i * 7) % 3);
+    }
+
+    for (int y = 0; y < CHECK_HEIGHT; y++) {
+        for (int x = 0; x < CHECK_WIDTH; x++) {
+            float range = 20.0f + (x * 37 + y * 11) % 20000;
+            float ndc = (CHECK_FAR + CHECK_NEAR) / (CHECK_FAR - CHECK_NEAR) -
+                        (2.0f * CHECK_FAR * CHECK_NEAR / (CHECK_FAR - CHECK_NEAR)) / range;
+            gDepth[y * CHECK_WIDTH + x] = y > CHECK_HEIGHT * 3 / 4 ? 1.0f : ndc * 0.5f + 0.5f;
+        }
+    }
+}
+
+// What the sim leaves behind before the plugin's draw callback: colour and depth
+static void DrawScene()
+{
+    glDisable(GL_BLEND);
+    glRasterPos2f(0, 0);
+    glDrawPixels(CHECK_WIDTH, CHECK_HEIGHT, GL_RGB, GL_UNSIGNED_BYTE, gScene);
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_ALWAYS);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDrawPixels(CHECK_WIDTH, CHECK_HEIGHT, GL_DEPTH_COMPONENT, GL_FLOAT, gDepth);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDisable(GL_DEPTH_TEST);
+}
+
+static void SetMode(int mode)
+{
+    SetMonochromeFilter(mode == 1);
+    SetThermalMode(mode == 2);
+    SetIRMode(mode == 3);
+}
+
+int main()
+{
+    if (!CreateHeadlessContext(CHECK_WIDTH, CHECK_HEIGHT)) {
+        printf("no offscreen GL context (try EGL_PLATFORM=surfaceless)\n");
+        return 2;
+    }
+
+    BuildScene();
+    InitializeVisualEffects();
+    if (GetVisualRenderer() != FLIR_RENDERER_POST_SHADER) {
+        printf("GLSL post-processing is not the default renderer\n");
+        return 1;
+    }
+
+    // Fill the CPU path's depth and readback rings before anything is compared
+    SetVisualRenderer(FLIR_RENDERER_POST_CPU);
+    SetMode(2);
+    for (int frame = 0; frame < CHECK_WARMUP_FRAMES; frame++) {
+        DrawScene();
+        RenderPostProcessing(CHECK_WIDTH, CHECK_HEIGHT);
+    }
+
+    static unsigned char shaderFrame[CHECK_WIDTH * CHECK_HEIGHT * 3];
+    static unsigned char cpuFrame[CHECK_WIDTH * CHECK_HEIGHT * 3];
+    int failures = 0;
+
+    for (int horizon = 0; horizon < 2; horizon++) {
+        for (int mode = 1; mode <= 3; mode++) {
+            gHorizonValid = horizon;
+            SetMode(mode);
+
+            SetVisualRenderer(FLIR_RENDERER_POST_SHADER);
+            DrawScene();
+            int drawn = RenderPostProcessing(CHECK_WIDTH, CHECK_HEIGHT);
+            glReadPixels(0, 0, CHECK_WIDTH, CHECK_HEIGHT, GL_RGB, GL_UNSIGNED_BYTE, shaderFrame);
+
+            SetVisualRenderer(FLIR_RENDERER_POST_CPU);
+            for (int frame = 0; frame < CHECK_CPU_FRAMES; frame++) {
+                DrawScene();
+                RenderPostProcessing(CHECK_WIDTH, CHECK_HEIGHT);
+            }
+            glReadPixels(0, 0, CHECK_WIDTH, CHECK_HEIGHT, GL_RGB, GL_UNSIGNED_BYTE, cpuFrame);
+
+            int differing = 0;
+            int maxDifference = 0;
+            for (int i = 0; i < CHECK_WIDTH * CHECK_HEIGHT * 3; i++) {
+                int difference = abs(shaderFrame[i] - cpuFrame[i]);
+                if (difference) differing++;
+                if (difference > maxDifference) maxDifference = difference;
+            }
+
+            GLenum error = glGetError();
+            printf("horizon %d mode %d: %d differing channels (max %d), GL error 0x%x\n",
+                   horizon, mode, differing, maxDifference, error);
+            if (!drawn) {
+                printf("shader path did not draw\n");
+                failures++;
+            }
+            if (differing || error != GL_NO_ERROR) failures++;
+        }
+    }
+
+    CleanupVisualEffects();
+
+    printf(failures ? "shader check FAILED (%d)\n" : "shader check passed\n", failures);
+    return failures ? 1 : 0;
+}
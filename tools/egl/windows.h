@@ -0,0 +1,17 @@
+/*
+ * Stand-in for <windows.h> when the GL modules are built on Linux for the
+ * headless checks: entry points come from EGL instead of opengl32.
+ */
+
+#ifndef FLIR_TOOLS_EGL_WINDOWS_H
+#define FLIR_TOOLS_EGL_WINDOWS_H
+
+#include <EGL/egl.h>
+
+#define wglGetProcAddress(name) ((void*)eglGetProcAddress(name))
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#endif // FLIR_TOOLS_EGL_WINDOWS_H